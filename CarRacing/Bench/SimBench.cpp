@@ -0,0 +1,1070 @@
+// Headless benchmark driver for the simulation core. Links only the GL-free
+// sources (Simulation, World, ...) so it runs on build boxes without a GPU.
+//
+// Usage: SimBench [worldIterations] [carTicks]
+// Output is one line per benchmark so it can be diffed between commits.
+
+#include "Simulation.h"
+#include "World.h"
+#include "TrackMesh.h"
+#include "Scenery.h"
+#include "Crowd.h"
+#include "SpatialGrid.h"
+#include "CarMesh.h"
+#include "Profiler.h"
+#include "Random.h"
+#include "TrackQuery.h"
+#include "TrackSpline.h"
+#include "SplineBatch.h"
+#include "WorldCache.h"
+#include "ThreadPool.h"
+#include "TextureImage.h"
+#include "BlockCompress.h"
+#include "TextureCache.h"
+#include "StaticBatch.h"
+#include "Vehicles.h"
+#include "AiDriver.h"
+#include "Collision.h"
+#include "SimThread.h"
+#include "InputQueue.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+
+typedef std::chrono::steady_clock BenchClock;
+
+static double elapsedNs(BenchClock::time_point start) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - start).count();
+}
+
+static void report(const char* name, long iterations, double totalNs, double checksum) {
+    printf("%-20s iters=%-10ld total_ms=%-10.3f ns_per_op=%-12.1f checksum=%.4f\n",
+        name, iterations, totalNs / 1e6, totalNs / iterations, checksum);
+}
+
+// ==================== WORLD GENERATION ====================
+static void benchWorldGeneration(long iterations) {
+    double checksum = 0.0;
+    BenchClock::time_point start = BenchClock::now();
+    for (long i = 0; i < iterations; i++) {
+        setWorldSeed(1234); // same world every iteration
+        generateWorld();
+        checksum += innerTrack.size() + audience.size() + trees.size() + buildings.size();
+    }
+    report("world_generation", iterations, elapsedNs(start), checksum / iterations);
+}
+
+// ==================== RANDOM STREAMS ====================
+// Raw generator throughput, and a check that a seed reproduces its world.
+template <typename Rng>
+static void benchRng(const char* name, long draws) {
+    Rng rng;
+    rng.seed(1234, 0);
+    uint32_t mix = 0;
+    BenchClock::time_point start = BenchClock::now();
+    for (long i = 0; i < draws; i++) mix ^= rng.next();
+    report(name, draws, elapsedNs(start), (double)(mix & 0xFFFF));
+}
+
+static double worldChecksum() {
+    double sum = 0.0;
+    for (const auto& p : innerTrack) sum += p.first + p.second;
+    for (const Person& p : audience) sum += p.x + p.z + p.r;
+    for (const Tree& t : trees) sum += t.x + t.z + t.height;
+    for (const TrackObject& o : trackObjects) sum += o.x + o.z + o.type;
+    for (const Building& b : buildings) sum += b.x + b.z + b.height;
+    return sum;
+}
+
+static void benchRandom(long iterations) {
+    benchRng<Pcg32>("rng_pcg32", iterations * 100000);
+    benchRng<Xoshiro128>("rng_xoshiro128", iterations * 100000);
+
+    // Same seed twice must give the same world; checksum is 1 when it does
+    setWorldSeed(1234);
+    generateWorld();
+    double first = worldChecksum();
+    setWorldSeed(99);
+    generateWorld();
+    setWorldSeed(1234);
+    BenchClock::time_point start = BenchClock::now();
+    generateWorld();
+    double totalNs = elapsedNs(start);
+    report("world_seed_repeat", 1, totalNs, worldChecksum() == first ? 1.0 : 0.0);
+}
+
+// ==================== TRACK MESH BUILD ====================
+// CPU side of the persistent track buffers: surface, kerbs and centre line.
+static void benchTrackMeshBuild(long iterations) {
+    setWorldSeed(1234);
+    generateWorld();
+
+    Mesh surface, kerbs, middleLine;
+    double checksum = 0.0;
+    BenchClock::time_point start = BenchClock::now();
+    for (long i = 0; i < iterations; i++) {
+        buildTrackSurfaceMesh(surface);
+        buildKerbMesh(kerbs);
+        buildMiddleLineMesh(middleLine);
+        checksum += surface.vertices.size() + kerbs.vertices.size() + middleLine.vertices.size();
+    }
+    report("track_mesh_build", iterations, elapsedNs(start), checksum / iterations);
+
+    std::vector<MeshInstance> tires;
+    checksum = 0.0;
+    start = BenchClock::now();
+    for (long i = 0; i < iterations; i++) {
+        buildTireBarrierInstances(tires);
+        checksum += tires.size();
+    }
+    report("tire_instance_build", iterations, elapsedNs(start), checksum / iterations);
+
+    // 10k spectators packed into the crowd instance layout
+    generateAudience(10000);
+    std::vector<CrowdInstance> crowd;
+    checksum = 0.0;
+    start = BenchClock::now();
+    for (long i = 0; i < iterations; i++) {
+        packCrowdInstances(audience, crowd);
+        checksum += crowd.size();
+    }
+    report("crowd_pack_10k", iterations, elapsedNs(start), checksum / iterations);
+
+    Mesh trunk, canopy, top;
+    checksum = 0.0;
+    start = BenchClock::now();
+    for (long i = 0; i < iterations; i++) {
+        for (int lod = 0; lod < TREE_LOD_LEVELS; lod++) {
+            buildTreeMeshes(lod, trunk, canopy, top);
+            checksum += trunk.vertices.size() + canopy.vertices.size() + top.vertices.size();
+        }
+    }
+    report("tree_mesh_build", iterations, elapsedNs(start), checksum / iterations);
+}
+
+// ==================== SCENERY CULLING ====================
+// Chase camera at points around the track, 10k spectators. The brute-force
+// pass tests every item and must see the same count as the grid.
+static void benchSceneryCull(long iterations) {
+    setWorldSeed(1234);
+    generateWorld();
+    generateAudience(10000);
+
+    SpatialGrid grid;
+    double checksum = 0.0;
+    BenchClock::time_point start = BenchClock::now();
+    for (long i = 0; i < iterations; i++) {
+        buildSceneryGrid(grid);
+        checksum += grid.items.size();
+    }
+    report("scenery_grid_build", iterations, elapsedNs(start), checksum / iterations);
+
+    float proj[16];
+    makePerspectiveMatrix(proj, 45.0f, 1100.0f / 700.0f, 0.1f, 1000.0f);
+    const int numViews = 64;
+    std::vector<Frustum> views(numViews);
+    for (int v = 0; v < numViews; v++) {
+        size_t a = innerTrack.size() * v / numViews;
+        size_t b = (a + 1) % innerTrack.size();
+        float modelview[16];
+        makeLookAtMatrix(modelview,
+            innerTrack[a].first, 6.0f, innerTrack[a].second,
+            innerTrack[b].first, 1.0f, innerTrack[b].second, 0.0f, 1.0f, 0.0f);
+        extractFrustum(views[v], proj, modelview);
+    }
+
+    VisibleScenery visible;
+    long frames = iterations * numViews;
+    checksum = 0.0;
+    start = BenchClock::now();
+    for (long i = 0; i < frames; i++) {
+        cullSpatialGrid(grid, views[i % numViews], visible);
+        for (int k = 0; k < SCENERY_KIND_COUNT; k++) checksum += visible.indices[k].size();
+    }
+    report("scenery_cull_grid", frames, elapsedNs(start), checksum / frames);
+
+    std::vector<SceneryItem> items;
+    gatherSceneryItems(items);
+    checksum = 0.0;
+    start = BenchClock::now();
+    for (long i = 0; i < frames; i++) {
+        const Frustum& frustum = views[i % numViews];
+        for (const SceneryItem& item : items) {
+            const SceneryBounds& b = item.bounds;
+            if (aabbInFrustum(frustum, b.minX, b.minY, b.minZ, b.maxX, b.maxY, b.maxZ)) checksum += 1.0;
+        }
+    }
+    report("scenery_cull_brute", frames, elapsedNs(start), checksum / frames);
+}
+
+// ==================== LEVEL OF DETAIL ====================
+// Building every level of the car parts and track objects, then per-frame
+// level selection for 10k objects with the camera driving around the
+// track. The checksum counts level switches per frame, which hysteresis
+// keeps low for objects sitting near a threshold.
+static void benchLod(long iterations) {
+    Mesh a, b;
+    double checksum = 0.0;
+    BenchClock::time_point start = BenchClock::now();
+    for (long i = 0; i < iterations; i++) {
+        for (int lod = 0; lod < CAR_LOD_LEVELS; lod++) {
+            buildWheelMeshes(lod, 6, a, b);
+            checksum += a.vertices.size() + b.vertices.size();
+            buildHelmetMesh(lod, a);
+            checksum += a.vertices.size();
+        }
+        for (int type = 0; type < TRACK_OBJECT_TYPES; type++) {
+            for (int lod = 0; lod < TRACK_OBJECT_LOD_LEVELS; lod++) {
+                buildTrackObjectMesh(type, lod, a);
+                checksum += a.vertices.size();
+            }
+        }
+    }
+    report("lod_mesh_build", iterations, elapsedNs(start), checksum / iterations);
+
+    setWorldSeed(1234);
+    generateWorld();
+    generateAudience(10000);
+    std::vector<signed char> levels(audience.size(), -1);
+    long frames = iterations * 10;
+    long switches = 0;
+    start = BenchClock::now();
+    for (long f = 0; f < frames; f++) {
+        const std::pair<float, float>& cam = innerTrack[f % innerTrack.size()];
+        for (size_t i = 0; i < audience.size(); i++) {
+            float dx = audience[i].x - cam.first, dz = audience[i].z - cam.second;
+            int lod = selectLod(TREE_LOD, sqrtf(dx * dx + dz * dz), levels[i]);
+            if (lod != levels[i]) switches++;
+            levels[i] = (signed char)lod;
+        }
+    }
+    report("lod_select_10k", frames, elapsedNs(start), (double)switches / frames);
+}
+
+// ==================== STATIC BATCHING ====================
+// Static scenery as merged chunks vs. one draw per building/stand part/track
+// object; checksums are draws per frame over the same views.
+static void benchStaticBatch(long iterations) {
+    setWorldSeed(1234);
+    generateWorld();
+
+    StaticBatch batch;
+    double checksum = 0.0;
+    BenchClock::time_point start = BenchClock::now();
+    for (long i = 0; i < iterations; i++) {
+        buildStaticBatch(batch);
+        for (const StaticChunk& chunk : batch.chunks) {
+            checksum += chunk.building.vertices.size() + chunk.colored[0].vertices.size();
+        }
+    }
+    report("static_batch_build", iterations, elapsedNs(start), checksum / iterations);
+
+    float proj[16];
+    makePerspectiveMatrix(proj, 45.0f, 1100.0f / 700.0f, 0.1f, 1000.0f);
+    const int numViews = 64;
+    std::vector<Frustum> views(numViews);
+    for (int v = 0; v < numViews; v++) {
+        size_t a = innerTrack.size() * v / numViews;
+        size_t b = (a + 6) % innerTrack.size(); // chase camera: 12 m behind the target
+        float modelview[16];
+        makeLookAtMatrix(modelview,
+            innerTrack[a].first, 6.0f, innerTrack[a].second,
+            innerTrack[b].first, 1.0f, innerTrack[b].second, 0.0f, 1.0f, 0.0f);
+        extractFrustum(views[v], proj, modelview);
+    }
+
+    long frames = iterations * numViews;
+    checksum = 0.0;
+    start = BenchClock::now();
+    for (long i = 0; i < frames; i++) {
+        const Frustum& frustum = views[i % numViews];
+        for (const StaticChunk& chunk : batch.chunks) {
+            const SceneryBounds& b = chunk.bounds;
+            if (!aabbInFrustum(frustum, b.minX, b.minY, b.minZ, b.maxX, b.maxY, b.maxZ)) continue;
+            checksum += (chunk.building.vertices.empty() ? 0 : 1) + (chunk.colored[0].vertices.empty() ? 0 : 1);
+        }
+    }
+    report("static_batch_cull", frames, elapsedNs(start), checksum / frames);
+
+    SpatialGrid grid;
+    buildSceneryGrid(grid);
+    VisibleScenery visible;
+    checksum = 0.0;
+    start = BenchClock::now();
+    for (long i = 0; i < frames; i++) {
+        cullSpatialGrid(grid, views[i % numViews], visible);
+        checksum += visible.indices[SCENERY_BUILDING].size() + 2 * visible.indices[SCENERY_STAND].size() +
+            visible.indices[SCENERY_TRACK_OBJECT].size();
+    }
+    report("static_item_cull", frames, elapsedNs(start), checksum / frames);
+}
+
+// ==================== PROFILER ====================
+// Cost of one scoped timer with recording off and on (two clock reads plus
+// a ring buffer write). Nested so the depth bookkeeping is exercised.
+static void benchProfiler(long iterations) {
+    long scopes = iterations * 10000;
+    volatile long sink = 0;
+
+    profilerEnabled = false;
+    BenchClock::time_point start = BenchClock::now();
+    for (long i = 0; i < scopes; i++) {
+        PROFILE_SCOPE("bench");
+        sink = sink + 1;
+    }
+    report("profile_scope_off", scopes, elapsedNs(start), (double)profileEventCount());
+
+    profilerEnabled = true;
+    profileClear();
+    start = BenchClock::now();
+    for (long i = 0; i < scopes / 2; i++) {
+        PROFILE_SCOPE("outer");
+        {
+            PROFILE_SCOPE("inner");
+            sink = sink + 1;
+        }
+        profileNextFrame();
+    }
+    report("profile_scope_on", scopes, elapsedNs(start), (double)profileEventCount());
+    profilerEnabled = false;
+    profileClear();
+}
+
+// ==================== TRACK SPLINE ====================
+// Rebuilding the arc-length table, O(1) evaluation at scattered distances,
+// and the worst deviation of the resampled centerline from even spacing
+// (checksum, in millimetres).
+static void benchTrackSpline(long iterations) {
+    setWorldSeed(1234);
+    generateWorld();
+
+    std::vector<std::pair<float, float>> controls;
+    for (size_t i = 0; i < trackSpline.spans.size(); i++) {
+        controls.push_back({ trackSpline.spans[i].ax, trackSpline.spans[i].az });
+    }
+
+    TrackSpline spline;
+    BenchClock::time_point start = BenchClock::now();
+    for (long i = 0; i < iterations; i++) buildTrackSpline(spline, controls);
+    report("spline_build", iterations, elapsedNs(start), spline.totalLength);
+
+    long evals = iterations * 10000;
+    double checksum = 0.0;
+    float stride = spline.totalLength * 0.3819660f; // golden-ratio stride visits the loop evenly
+    start = BenchClock::now();
+    for (long i = 0; i < evals; i++) {
+        TrackSplinePoint p = evaluateTrackSpline(spline, i * stride);
+        checksum += p.curvature;
+    }
+    report("spline_eval", evals, elapsedNs(start), checksum / evals);
+
+    std::vector<TrackSplinePoint> points;
+    start = BenchClock::now();
+    for (long i = 0; i < iterations; i++) resampleTrackSpline(spline, 2.0f, points);
+    double totalNs = elapsedNs(start);
+
+    float step = spline.totalLength / points.size();
+    float worst = 0.0f;
+    for (size_t i = 0; i < points.size(); i++) {
+        const TrackSplinePoint& a = points[i];
+        const TrackSplinePoint& b = points[(i + 1) % points.size()];
+        float d = sqrtf((b.x - a.x) * (b.x - a.x) + (b.z - a.z) * (b.z - a.z));
+        worst = std::max(worst, fabsf(d - step));
+    }
+    report("spline_resample", iterations, totalNs, worst * 1000.0f);
+}
+
+// ==================== WORLD CACHE ====================
+// Writing the generated world once, then mapping it (zero-copy views) and
+// loading it into the globals. The load checksum counts arrays that differ
+// from the generated ones (should be 0).
+template <typename T>
+static int differs(const std::vector<T>& a, const std::vector<T>& b) {
+    return a.size() != b.size() || memcmp(a.data(), b.data(), a.size() * sizeof(T)) != 0;
+}
+
+static void benchWorldCache(long iterations) {
+    const char* path = "simbench_world.bin";
+    setWorldSeed(1234);
+    generateWorld();
+    std::vector<std::pair<float, float>> inner = innerTrack;
+    std::vector<Person> people = audience;
+    std::vector<Tree> trees0 = trees;
+    std::vector<float> table = trackSpline.tableU;
+
+    BenchClock::time_point start = BenchClock::now();
+    for (long i = 0; i < iterations; i++) saveWorldCache(path, NUM_AUDIENCE);
+    report("world_cache_save", iterations, elapsedNs(start), 0.0);
+
+    MappedWorld world;
+    size_t count = 0;
+    start = BenchClock::now();
+    for (long i = 0; i < iterations; i++) {
+        if (!mapWorldCache(path, world)) break;
+        worldCacheSection(world, WORLD_SECTION_AUDIENCE, count);
+        unmapWorldCache(world);
+    }
+    report("world_cache_map", iterations, elapsedNs(start), (double)count);
+
+    int loaded = 0;
+    start = BenchClock::now();
+    for (long i = 0; i < iterations; i++) loaded += loadWorldCache(path, 1234, NUM_AUDIENCE);
+    double totalNs = elapsedNs(start);
+    int mismatches = (loaded != iterations) + differs(inner, innerTrack) + differs(people, audience) +
+        differs(trees0, trees) + differs(table, trackSpline.tableU);
+    report("world_cache_load", iterations, totalNs, mismatches);
+
+    remove(path);
+}
+
+// ==================== TEXTURE PREPARE ====================
+// The CPU half of startup texture loading (flip, power-of-two resample, mip
+// chain) for images the size of the game's seven JPEGs, one after another
+// and spread over the worker pool. Decoding needs SOIL, so it is left out.
+static void benchTexturePrepare(long iterations) {
+    const int sizes[7][2] = {
+        { 225, 225 }, { 275, 183 }, { 612, 377 }, { 612, 408 }, { 225, 225 }, { 288, 175 }, { 106, 400 }
+    };
+    std::vector<std::vector<unsigned char>> sources(7);
+    Pcg32 rng;
+    rng.seed(1234, 0);
+    for (int i = 0; i < 7; i++) {
+        sources[i].resize((size_t)sizes[i][0] * sizes[i][1] * 4);
+        for (unsigned char& c : sources[i]) c = (unsigned char)rng.next();
+    }
+
+    std::vector<TextureImage> images(7);
+    BenchClock::time_point start = BenchClock::now();
+    for (long it = 0; it < iterations; it++) {
+        for (int i = 0; i < 7; i++) prepareTextureImage(sources[i].data(), sizes[i][0], sizes[i][1], images[i]);
+    }
+    double bytes = 0.0;
+    for (const TextureImage& image : images) {
+        for (const TextureLevel& level : image.levels) bytes += level.data.size();
+    }
+    report("texture_prep_serial", iterations * 7, elapsedNs(start), bytes);
+
+    ThreadPool pool;
+    startThreadPool(pool, defaultWorkerCount());
+    start = BenchClock::now();
+    for (long it = 0; it < iterations; it++) {
+        for (int i = 0; i < 7; i++) {
+            submitTask(pool, [&, i] { prepareTextureImage(sources[i].data(), sizes[i][0], sizes[i][1], images[i]); });
+        }
+        waitThreadPool(pool);
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "texture_prep_pool_%d", (int)pool.workers.size());
+    report(name, iterations * 7, elapsedNs(start), bytes);
+
+    // BC1 encoding of the prepared chains (checksum: compressed / RGBA8
+    // bytes), then reading the baked chains back as a later launch would
+    std::vector<TextureImage> compressed = images;
+    start = BenchClock::now();
+    for (long it = 0; it < iterations; it++) {
+        compressed = images;
+        for (TextureImage& image : compressed) compressTextureImage(image, TEXTURE_BC1);
+    }
+    double compressedBytes = 0.0;
+    for (const TextureImage& image : compressed) {
+        for (const TextureLevel& level : image.levels) compressedBytes += level.data.size();
+    }
+    report("texture_bc1_encode", iterations * 7, elapsedNs(start), compressedBytes / bytes);
+
+    const char* path = "simbench_texture.rtex";
+    int loaded = 0;
+    TextureImage baked;
+    saveBakedTexture(path, 1234, compressed[2]);
+    start = BenchClock::now();
+    for (long it = 0; it < iterations * 7; it++) loaded += loadBakedTexture(path, 1234, baked);
+    report("texture_baked_load", iterations * 7, elapsedNs(start), loaded == iterations * 7 &&
+        baked.levels[0].data == compressed[2].levels[0].data);
+    remove(path);
+}
+
+// ==================== SPLINE BATCH ====================
+// Tessellating the whole track loop at high density: one catmullRom() call
+// per point, the batch kernel forced scalar, and the batch kernel with SIMD.
+// Checksums are the worst difference from the per-point results.
+static void benchSplineBatch(long iterations) {
+    setWorldSeed(1234);
+    generateWorld();
+
+    const int steps = 64;
+    size_t n = trackSpline.spans.size();
+    std::vector<std::pair<float, float>> controls(n);
+    std::vector<float> controlX(n), controlZ(n);
+    for (size_t i = 0; i < n; i++) {
+        controls[i] = { trackSpline.spans[i].ax, trackSpline.spans[i].az };
+        controlX[i] = controls[i].first;
+        controlZ[i] = controls[i].second;
+    }
+
+    std::vector<std::pair<float, float>> reference(n * steps);
+    BenchClock::time_point start = BenchClock::now();
+    for (long it = 0; it < iterations; it++) {
+        for (size_t i = 0; i < n; i++) {
+            const std::pair<float, float>& p0 = controls[(i + n - 1) % n];
+            const std::pair<float, float>& p2 = controls[(i + 1) % n];
+            const std::pair<float, float>& p3 = controls[(i + 2) % n];
+            for (int k = 0; k < steps; k++) {
+                reference[i * steps + k] = catmullRom(p0, controls[i], p2, p3, k / (float)steps);
+            }
+        }
+    }
+    report("catmull_per_point", iterations * n * steps, elapsedNs(start), reference[steps / 2].first);
+
+    std::vector<float> outX(n * steps), outZ(n * steps);
+    for (int simd = 0; simd < 2; simd++) {
+        splineSimdEnabled = simd != 0;
+        char name[32];
+        snprintf(name, sizeof(name), "catmull_batch_%s", splineSimdIsa());
+
+        start = BenchClock::now();
+        for (long it = 0; it < iterations; it++) {
+            tessellateCatmullRomLoop(controlX.data(), controlZ.data(), n, steps, outX.data(), outZ.data());
+        }
+        double totalNs = elapsedNs(start);
+
+        float worst = 0.0f;
+        for (size_t i = 0; i < n * steps; i++) {
+            worst = std::max(worst, fabsf(outX[i] - reference[i].first));
+            worst = std::max(worst, fabsf(outZ[i] - reference[i].second));
+        }
+        report(name, iterations * n * steps, totalNs, worst);
+    }
+    splineSimdEnabled = true;
+}
+
+// ==================== TRACK QUERIES ====================
+// 10k points scattered up to 8 m either side of the track, answered by the
+// BVH and by scanning every segment. The brute-force checksum is the
+// number of points where the two disagree on distance (expected 0).
+static void benchTrackQuery(long iterations) {
+    setWorldSeed(1234);
+    generateWorld();
+
+    TrackIndex index;
+    BenchClock::time_point start = BenchClock::now();
+    for (long i = 0; i < iterations; i++) buildTrackIndex(index);
+    report("track_index_build", iterations, elapsedNs(start), (double)index.nodes.size());
+
+    const int numPoints = 10000;
+    std::vector<std::pair<float, float>> points(numPoints);
+
+    Pcg32 rng;
+    rng.seed(42, 0);
+    for (int i = 0; i < numPoints; i++) {
+        const TrackSegment& s = index.segments[rng.next() % index.segments.size()];
+        float side = (rng.next() >> 8) * (1.0f / 16777216.0f) * 16.0f - 8.0f;
+        float along = (rng.next() >> 8) * (1.0f / 16777216.0f);
+        points[i].first = s.x0 + s.dx * along - s.dz * s.invLen2 * s.length * side;
+        points[i].second = s.z0 + s.dz * along + s.dx * s.invLen2 * s.length * side;
+    }
+
+    std::vector<float> distances(numPoints);
+    long queries = iterations * numPoints;
+    double checksum = 0.0;
+    start = BenchClock::now();
+    for (long i = 0; i < queries; i++) {
+        int p = (int)(i % numPoints);
+        TrackQueryResult r = queryTrack(index, points[p].first, points[p].second);
+        distances[p] = r.distance;
+        checksum += r.onTrack ? 1.0 : 0.0;
+    }
+    report("track_query_bvh", queries, elapsedNs(start), checksum / iterations);
+
+    long mismatches = 0;
+    start = BenchClock::now();
+    for (int p = 0; p < numPoints; p++) {
+        float best = 1e30f;
+        for (const TrackSegment& s : index.segments) {
+            float t = ((points[p].first - s.x0) * s.dx + (points[p].second - s.z0) * s.dz) * s.invLen2;
+            t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+            float dx = s.x0 + s.dx * t - points[p].first;
+            float dz = s.z0 + s.dz * t - points[p].second;
+            float d2 = dx * dx + dz * dz;
+            if (d2 < best) best = d2;
+        }
+        if (fabsf(sqrtf(best) - distances[p]) > 1e-4f) mismatches++;
+    }
+    report("track_query_brute", numPoints, elapsedNs(start), (double)mismatches);
+}
+
+// ==================== CAR UPDATE ====================
+static void benchCarUpdate(long ticks) {
+    setWorldSeed(1234);
+    generateWorld();
+
+    CarState car;
+    resetCar(car);
+    CarInput input;
+    const float deltaTime = 1.0f / 60.0f;
+
+    BenchClock::time_point start = BenchClock::now();
+    for (long i = 0; i < ticks; i++) {
+        // Scripted driver: accelerate, weave, coast, brake.
+        long phase = i % 600;
+        input.forward = phase < 300;
+        input.backward = phase >= 500;
+        input.left = (phase / 50) % 4 == 1;
+        input.right = (phase / 50) % 4 == 3;
+        updateCar(car, input, deltaTime);
+    }
+    double totalNs = elapsedNs(start);
+    report("car_update", ticks, totalNs, car.x + car.z + car.angle + car.speed);
+}
+
+// ==================== VEHICLE SET ====================
+// A grid of cars on the same scripted inputs as car_update, each car a
+// different point in the script. Per-car updateCar() over an array of
+// CarState vs. one updateVehicles() call; ns_per_op is per car step.
+static void benchVehicles(int cars, long carSteps) {
+    setWorldSeed(1234);
+    generateWorld();
+    TrackIndex track;
+    buildTrackIndex(track);
+
+    VehicleSet set;
+    resizeVehicles(set, cars);
+    placeVehiclesOnGrid(set, track);
+    std::vector<CarState> states(cars);
+    std::vector<CarInput> inputs(cars);
+    for (int c = 0; c < cars; c++) {
+        states[c] = getVehicle(set, c);
+        long phase = (c * 37) % 600;
+        inputs[c].forward = phase < 300;
+        inputs[c].backward = phase >= 500;
+        inputs[c].left = (phase / 50) % 4 == 1;
+        inputs[c].right = (phase / 50) % 4 == 3;
+        setVehicleInput(set, c, inputs[c]);
+    }
+
+    const float deltaTime = 1.0f / 60.0f;
+    long ticks = carSteps / cars + 1;
+    char name[32];
+
+    BenchClock::time_point start = BenchClock::now();
+    for (long i = 0; i < ticks; i++) {
+        for (int c = 0; c < cars; c++) updateCar(states[c], inputs[c], deltaTime);
+    }
+    double totalNs = elapsedNs(start);
+    double checksum = 0.0;
+    for (const CarState& car : states) checksum += car.x + car.z;
+    snprintf(name, sizeof(name), "cars_scalar_%d", cars);
+    report(name, ticks * cars, totalNs, checksum / cars);
+
+    start = BenchClock::now();
+    for (long i = 0; i < ticks; i++) updateVehicles(set, deltaTime);
+    totalNs = elapsedNs(start);
+    checksum = 0.0;
+    for (int c = 0; c < cars; c++) checksum += set.x[c] + set.z[c];
+    snprintf(name, sizeof(name), "cars_soa_%d", cars);
+    report(name, ticks * cars, totalNs, checksum / cars);
+}
+
+// ==================== AI DRIVERS ====================
+// The racing line for the benchmark world, built once for every AI bench.
+// The checksum is the average target speed along it.
+static void benchRacingLine(RacingLine& line) {
+    setWorldSeed(1234);
+    generateWorld();
+
+    BenchClock::time_point start = BenchClock::now();
+    buildRacingLine(line, trackSpline);
+    double totalNs = elapsedNs(start);
+    double checksum = 0.0;
+    for (float v : line.speed) checksum += v;
+    report("racing_line_build", 1, totalNs, checksum / line.speed.size());
+}
+
+// AI cars racing at 120 Hz on line: driven serially and through the pool.
+// The checksum of the drive is the average number of laps (from each
+// driver's line position), so a driver that stalls shows up there, not
+// just in the timing. The race physics is reported for the serial pass:
+// ai_race_offtrack_* times the off-track drag and ai_race_scenery_* the
+// scenery collisions, with the percentage of car steps spent off track
+// and against scenery as their checksums.
+static void benchAiDrivers(const RacingLine& line, int cars, long carSteps) {
+    setWorldSeed(1234);
+    generateWorld();
+    TrackIndex track;
+    buildTrackIndex(track);
+
+    CollisionWorld collision;
+    buildCollisionWorld(collision, track);
+
+    const int samples = (int)line.x.size();
+    ThreadPool pool;
+    char name[32];
+    for (int pass = 0; pass < 2; pass++) {
+        startThreadPool(pool, pass == 0 ? 0 : defaultWorkerCount());
+        VehicleSet set;
+        resizeVehicles(set, cars);
+        placeVehiclesOnGrid(set, track);
+        AiDrivers ai;
+        resetAiDrivers(ai, line, set);
+        std::vector<int> lastIndex = ai.lineIndex;
+        std::vector<long> travelled(cars, 0);
+
+        const float deltaTime = 1.0f / 120.0f;
+        long ticks = carSteps / cars + 1;
+        double driveNs = 0.0, offTrackNs = 0.0, collideNs = 0.0;
+        long offTrackSteps = 0, collidingSteps = 0;
+        VehicleSet prev;
+        for (long i = 0; i < ticks; i++) {
+            prev = set;
+            BenchClock::time_point start = BenchClock::now();
+            driveAiCarsParallel(pool, line, ai, set, 0);
+            driveNs += elapsedNs(start);
+            updateVehicles(set, deltaTime);
+            start = BenchClock::now();
+            applyVehicleOffTrackDrag(set, track, deltaTime);
+            offTrackNs += elapsedNs(start);
+            start = BenchClock::now();
+            collideVehicles(collision, prev, set);
+            collideNs += elapsedNs(start);
+
+            for (int c = 0; c < cars; c++) {
+                offTrackSteps += set.offTrack[c];
+                collidingSteps += set.colliding[c];
+                int delta = ai.lineIndex[c] - lastIndex[c];
+                if (delta < -samples / 2) delta += samples;
+                if (delta > samples / 2) delta -= samples;
+                travelled[c] += delta;
+                lastIndex[c] = ai.lineIndex[c];
+            }
+        }
+        double checksum = 0.0;
+        for (long t : travelled) checksum += (double)t / samples;
+        snprintf(name, sizeof(name), "ai_drive_%s_%d", pass == 0 ? "serial" : "pool", cars);
+        report(name, ticks * cars, driveNs, checksum / cars);
+        if (pass == 0) {
+            snprintf(name, sizeof(name), "ai_race_offtrack_%d", cars);
+            report(name, ticks * cars, offTrackNs, 100.0 * offTrackSteps / (ticks * cars));
+            snprintf(name, sizeof(name), "ai_race_scenery_%d", cars);
+            report(name, ticks * cars, collideNs, 100.0 * collidingSteps / (ticks * cars));
+        }
+        stopThreadPool(pool);
+    }
+}
+
+// ==================== COLLISION ====================
+// Building the collision grid, then cars against the scenery through the
+// grid vs. testing every box, and swept vs. discrete stops against a thin
+// wall. Checksums count cars touching scenery, and for the wall cars that
+// tunnelled through it.
+static void benchCollision(long iterations) {
+    setWorldSeed(1234);
+    generateWorld();
+    TrackIndex track;
+    buildTrackIndex(track);
+
+    CollisionWorld world;
+    BenchClock::time_point start = BenchClock::now();
+    for (long i = 0; i < iterations; i++) buildCollisionWorld(world, track);
+    report("collision_world_build", iterations, elapsedNs(start), (double)world.colliders.size());
+
+    // Cars scattered over the track and a car length either side of it, so
+    // a share of them touch the edge stacks
+    const int numCars = 10000;
+    std::vector<CarState> cars(numCars);
+    Pcg32 rng;
+    rng.seed(42, 0);
+    for (int i = 0; i < numCars; i++) {
+        const TrackSegment& s = track.segments[rng.next() % track.segments.size()];
+        float side = (rng.next() >> 8) * (1.0f / 16777216.0f) * 20.0f - 10.0f;
+        float along = (rng.next() >> 8) * (1.0f / 16777216.0f);
+        resetCar(cars[i]);
+        cars[i].x = s.x0 + s.dx * along - s.dz * s.invLen2 * s.length * side;
+        cars[i].z = s.z0 + s.dz * along + s.dx * s.invLen2 * s.length * side;
+        cars[i].angle = (rng.next() >> 8) * (1.0f / 16777216.0f) * 360.0f - 180.0f;
+    }
+
+    // Checksum: cars touching anything, the same for both
+    long tests = iterations * numCars;
+    double checksum = 0.0;
+    start = BenchClock::now();
+    for (long i = 0; i < tests; i++) {
+        CarState car = cars[i % numCars];
+        checksum += collideCar(world, car) > 0 ? 1.0 : 0.0;
+    }
+    report("collide_car_grid", tests, elapsedNs(start), checksum / iterations);
+
+    checksum = 0.0;
+    start = BenchClock::now();
+    for (int i = 0; i < numCars; i++) {
+        float pushX, pushZ;
+        for (const Collider& c : world.colliders) {
+            if (carOverlapsCollider(c, cars[i].x, cars[i].z, cars[i].angle, pushX, pushZ)) {
+                checksum += 1.0;
+                break;
+            }
+        }
+    }
+    report("collide_car_brute", numCars, elapsedNs(start), checksum);
+
+    // Cars at full speed into a wall of barriers 0.5 m thick, at physics
+    // rates down to one where a step is longer than the wall is thick.
+    // Checksum: cars that came out the far side.
+    CollisionWorld wall;
+    for (int i = 0; i < 50; i++) {
+        Collider c;
+        c.minX = -50.0f + 2.0f * i; c.maxX = c.minX + 2.0f;
+        c.minZ = -0.25f; c.maxZ = 0.25f;
+        c.kind = COLLIDER_BARRIER;
+        c.index = i;
+        wall.colliders.push_back(c);
+    }
+    buildCollisionGrid(wall);
+
+    const int wallCars = 1000;
+    VehicleSet approach;
+    resizeVehicles(approach, wallCars);
+    for (int i = 0; i < wallCars; i++) {
+        approach.x[i] = (rng.next() >> 8) * (1.0f / 16777216.0f) * 80.0f - 40.0f;
+        approach.z[i] = -20.0f;
+        approach.angle[i] = (rng.next() >> 8) * (1.0f / 16777216.0f) * 60.0f - 30.0f;
+        approach.speed[i] = MAX_SPEED_FW;
+        approach.throttle[i] = 1.0f;
+    }
+
+    const float rates[] = { 120.0f, 30.0f, 10.0f };
+    char name[32];
+    for (float hz : rates) {
+        for (int swept = 0; swept < 2; swept++) {
+            VehicleSet set = approach, prev, none;
+            const float deltaTime = 1.0f / hz;
+            long ticks = (long)(1.5f * hz);
+            double collideNs = 0.0;
+            for (long i = 0; i < ticks; i++) {
+                prev = set;
+                updateVehicles(set, deltaTime);
+                start = BenchClock::now();
+                collideVehicles(wall, swept ? prev : none, set);
+                collideNs += elapsedNs(start);
+            }
+            int through = 0;
+            for (int c = 0; c < wallCars; c++) through += set.z[c] > 0.0f ? 1 : 0;
+            snprintf(name, sizeof(name), "collide_%s_%dhz", swept ? "swept" : "discrete", (int)hz);
+            report(name, ticks * wallCars, collideNs, (double)through);
+        }
+    }
+}
+
+// ==================== SIMULATION THREAD ====================
+struct BenchDrivers {
+    const RacingLine* line;
+    AiDrivers* ai;
+};
+
+static void driveBenchCars(VehicleSet& set, void* data) {
+    BenchDrivers* drivers = (BenchDrivers*)data;
+    driveAiCars(*drivers->line, *drivers->ai, set, 0, set.count);
+}
+
+// Snapshot publish and pickup cost, then the thread stepping AI cars behind
+// a renderer with hitches, against the same frames stepping physics inline.
+static void benchSimThread(int cars) {
+    setWorldSeed(1234);
+    generateWorld();
+    TrackIndex track;
+    buildTrackIndex(track);
+    CollisionWorld collision;
+    buildCollisionWorld(collision, track);
+    RacingLine line;
+    buildRacingLine(line, trackSpline);
+
+    SimThread sim;
+    resizeVehicles(sim.cars, cars);
+    placeVehiclesOnGrid(sim.cars, track);
+    AiDrivers ai;
+    resetAiDrivers(ai, line, sim.cars);
+    BenchDrivers drivers = { &line, &ai };
+    sim.prev = sim.cars;
+    sim.track = &track;
+    sim.collision = &collision;
+    sim.control = driveBenchCars;
+    sim.controlData = &drivers;
+
+    // Publishing and picking up a snapshot, on this thread
+    const long copies = 1000;
+    BenchClock::time_point start = BenchClock::now();
+    for (long i = 0; i < copies; i++) {
+        SimSnapshot& snapshot = snapshotForWriting(sim.snapshots);
+        snapshot.prev = sim.prev;
+        snapshot.cars = sim.cars;
+        publishSnapshot(sim.snapshots);
+    }
+    report("snapshot_publish", copies, elapsedNs(start), (double)snapshotForWriting(sim.snapshots).cars.count);
+    start = BenchClock::now();
+    double checksum = 0.0;
+    for (long i = 0; i < copies; i++) checksum += latestSnapshot(sim.snapshots).cars.count;
+    report("snapshot_read", copies, elapsedNs(start), checksum / copies);
+
+    // A "renderer" with 10 ms frames and a 300 ms hitch every 20 frames:
+    // the simulation keeps its own rate through them. Checksum: steps run
+    // per second of wall time.
+    const int frames = 60;
+    long long lastSteps = -1;
+    int newSnapshots = 0;
+    startSimThread(sim);
+    start = BenchClock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        const SimSnapshot& snapshot = latestSnapshot(sim.snapshots);
+        if (snapshot.steps != lastSteps) newSnapshots++;
+        lastSteps = snapshot.steps;
+        std::this_thread::sleep_for(std::chrono::milliseconds(frame % 20 == 19 ? 300 : 10));
+    }
+    double wallNs = elapsedNs(start);
+    stopSimThread(sim);
+    long long steps = latestSnapshot(sim.snapshots).steps;
+    char name[32];
+    snprintf(name, sizeof(name), "sim_thread_%d", cars);
+    report(name, steps, wallNs, steps / (wallNs * 1e-9));
+    snprintf(name, sizeof(name), "sim_thread_snapshots_%d", cars);
+    report(name, frames, wallNs, (double)newSnapshots);
+
+    // The same frames stepping physics themselves, as idleFunc() used to:
+    // each hitch is cut to maxSubsteps and the rest of it is lost.
+    // Checksum: steps per second of the frames' time.
+    FixedStepClock clock;
+    VehicleSet set = sim.cars, prev = sim.cars;
+    long inlineSteps = 0;
+    float frameSeconds = 0.0f;
+    start = BenchClock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        float frameTime = frame % 20 == 19 ? 0.3f : 0.01f;
+        frameSeconds += frameTime;
+        inlineSteps += stepVehiclesFixed(clock, prev, set, frameTime, &track, &collision,
+            driveBenchCars, &drivers);
+    }
+    snprintf(name, sizeof(name), "sim_thread_inline_%d", cars);
+    report(name, inlineSteps, elapsedNs(start), inlineSteps / frameSeconds);
+}
+
+// ==================== INPUT QUEUE ====================
+// Events through the ring between two threads (checksum: average key bit
+// popped), then short taps delivered through the queue vs. sampled at each
+// physics step.
+static void benchInputQueue(long events) {
+    // One thread pushing, this one popping
+    InputQueue queue;
+    BenchClock::time_point start = BenchClock::now();
+    std::thread producer([&] {
+        for (long i = 0; i < events; i++) {
+            InputEvent event;
+            event.timeNs = i;
+            event.key = 1u << (i & 3);
+            event.pressed = (i & 4) != 0;
+            while (!pushInputEvent(queue, event)) std::this_thread::yield();
+        }
+    });
+    double checksum = 0.0;
+    InputEvent event;
+    for (long popped = 0; popped < events;) {
+        if (popInputEvent(queue, events, event)) {
+            checksum += event.key;
+            popped++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    report("input_queue_spsc", events, elapsedNs(start), checksum / events);
+
+    // 2 ms taps against 120 Hz steps. Checksum: taps that reached a step,
+    // read from the queue vs sampling the key state at each step.
+    const int taps = 1000;
+    const long long stepNs = 1000000000LL / 120, tapNs = 2000000;
+    Pcg32 rng;
+    rng.seed(42, 0);
+    InputState state;
+    long long stepStart = 0, tapStart = 0;
+    int seenQueued = 0, seenSampled = 0;
+    start = BenchClock::now();
+    for (int tap = 0; tap < taps; tap++) {
+        tapStart += 30000000 + rng.next() % 20000000;
+        InputEvent down = { tapStart, SIM_INPUT_FORWARD, true };
+        InputEvent up = { tapStart + tapNs, SIM_INPUT_FORWARD, false };
+        pushInputEvent(queue, down);
+        pushInputEvent(queue, up);
+
+        bool queued = false, sampled = false;
+        while (stepStart <= tapStart + tapNs + stepNs) {
+            queued |= (consumeInputEvents(queue, state, stepStart) & SIM_INPUT_FORWARD) != 0;
+            sampled |= stepStart >= tapStart && stepStart < tapStart + tapNs;
+            stepStart += stepNs;
+        }
+        seenQueued += queued ? 1 : 0;
+        seenSampled += sampled ? 1 : 0;
+    }
+    double tapsNs = elapsedNs(start);
+    report("input_taps_queued", taps, tapsNs, (double)seenQueued);
+    report("input_taps_sampled", taps, tapsNs, (double)seenSampled);
+}
+
+// ==================== FIXED TIMESTEP ====================
+// Feeds a jittery render frame rate through the accumulator; physics cost per
+// frame is bounded by maxSubsteps regardless of how slow a frame was.
+static void benchFixedStep(long frames) {
+    setWorldSeed(1234);
+    generateWorld();
+
+    CarState car;
+    resetCar(car);
+    CarState prevCar = car;
+    CarInput input;
+    input.forward = true;
+    FixedStepClock clock;
+
+    const float frameTimes[] = { 0.008f, 0.016f, 0.016f, 0.033f, 0.250f };
+    long totalSteps = 0;
+
+    BenchClock::time_point start = BenchClock::now();
+    for (long i = 0; i < frames; i++) {
+        input.left = (i / 120) % 2 == 0;
+        totalSteps += stepCarFixed(clock, prevCar, car, input, frameTimes[i % 5]);
+        CarState view = interpolateCar(prevCar, car, fixedStepAlpha(clock));
+        (void)view;
+    }
+    double totalNs = elapsedNs(start);
+    report("fixed_step_frame", frames, totalNs, (double)totalSteps / frames);
+}
+
+// ==================== MAIN ====================
+int main(int argc, char** argv) {
+    long worldIterations = argc > 1 ? atol(argv[1]) : 200;
+    long carTicks = argc > 2 ? atol(argv[2]) : 10000000;
+    if (worldIterations < 1) worldIterations = 1;
+    if (carTicks < 1) carTicks = 1;
+
+    benchWorldGeneration(worldIterations);
+    benchRandom(worldIterations);
+    benchWorldCache(worldIterations);
+    benchTexturePrepare(worldIterations / 10 + 1);
+    benchTrackMeshBuild(worldIterations);
+    benchSceneryCull(worldIterations);
+    benchStaticBatch(worldIterations);
+    benchLod(worldIterations);
+    benchProfiler(worldIterations);
+    benchTrackQuery(worldIterations);
+    benchTrackSpline(worldIterations);
+    benchSplineBatch(worldIterations);
+    benchCarUpdate(carTicks);
+    benchFixedStep(carTicks / 10);
+    benchVehicles(20, carTicks);
+    benchVehicles(1000, carTicks);
+    RacingLine racingLine;
+    benchRacingLine(racingLine);
+    benchAiDrivers(racingLine, 20, carTicks / 100);
+    benchAiDrivers(racingLine, 1000, carTicks / 10);
+    benchCollision(worldIterations);
+    benchSimThread(20);
+    benchInputQueue(carTicks);
+    return 0;
+}
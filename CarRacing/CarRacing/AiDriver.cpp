@@ -0,0 +1,210 @@
+#include "AiDriver.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// Menger curvature of the circle through three points: 4 * area / (abc)
+static float curvatureThrough(float ax, float az, float bx, float bz, float cx, float cz) {
+    float abx = bx - ax, abz = bz - az;
+    float bcx = cx - bx, bcz = cz - bz;
+    float cax = ax - cx, caz = az - cz;
+    float cross = abx * bcz - abz * bcx;
+    float lengths = sqrtf((abx * abx + abz * abz) * (bcx * bcx + bcz * bcz) * (cax * cax + caz * caz));
+    return lengths > 0.0f ? 2.0f * std::fabs(cross) / lengths : 0.0f;
+}
+
+void buildRacingLine(RacingLine& line, const TrackSpline& spline, float spacing) {
+    line = RacingLine();
+    if (spline.spans.empty()) return;
+
+    std::vector<TrackSplinePoint> center;
+    resampleTrackSpline(spline, spacing, center);
+    const int n = (int)center.size();
+    if (n < 3) return;
+    line.totalLength = spline.totalLength;
+    line.spacing = spline.totalLength / n;
+
+    // --- Offsets: move each point towards the midpoint of its neighbours ---
+    // The fixed point minimizes the summed squared bending of the path; the
+    // clamp keeps it on the tarmac.
+    const float limit = TRACK_WIDTH * 0.5f - RACING_LINE_MARGIN;
+    line.offset.assign(n, 0.0f);
+    line.x.resize(n);
+    line.z.resize(n);
+    for (int i = 0; i < n; i++) {
+        line.x[i] = center[i].x;
+        line.z[i] = center[i].z;
+    }
+    for (int pass = 0; pass < RACING_LINE_ITERATIONS; pass++) {
+        for (int i = 0; i < n; i++) {
+            int before = (i + n - 1) % n, after = (i + 1) % n;
+            float mx = 0.5f * (line.x[before] + line.x[after]);
+            float mz = 0.5f * (line.z[before] + line.z[after]);
+            const TrackSplinePoint& c = center[i];
+            float offset = (mx - c.x) * -c.tz + (mz - c.z) * c.tx;
+            offset = std::min(std::max(offset, -limit), limit);
+            line.offset[i] = offset;
+            line.x[i] = c.x - c.tz * offset;
+            line.z[i] = c.z + c.tx * offset;
+        }
+    }
+
+    // --- Cornering speed: the car turns at a fixed rate, so v = rate / k ---
+    const float turnRate = AI_CORNER_GRIP * TURN_ANGLE * M_PI_F / 180.0f;
+    std::vector<float> curvature(n);
+    for (int i = 0; i < n; i++) {
+        int before = (i + n - 1) % n, after = (i + 1) % n;
+        curvature[i] = curvatureThrough(line.x[before], line.z[before], line.x[i], line.z[i],
+            line.x[after], line.z[after]);
+    }
+    line.speed.resize(n);
+    for (int i = 0; i < n; i++) {
+        // Widest of the three: one noisy sample should not set the speed
+        float k = std::max(curvature[i], std::max(curvature[(i + n - 1) % n], curvature[(i + 1) % n]));
+        line.speed[i] = k > 0.0f ? std::min(MAX_SPEED_FW, std::max(turnRate / k, AI_MIN_CORNER_SPEED)) : MAX_SPEED_FW;
+    }
+
+    // --- Braking: v^2 <= v_next^2 + 2 a d, twice round so it wraps ---
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = n - 1; i >= 0; i--) {
+            int after = (i + 1) % n;
+            float dx = line.x[after] - line.x[i], dz = line.z[after] - line.z[i];
+            float d = sqrtf(dx * dx + dz * dz);
+            float reachable = sqrtf(line.speed[after] * line.speed[after] + 2.0f * ACCELERATION * d);
+            line.speed[i] = std::min(line.speed[i], reachable);
+        }
+    }
+}
+
+void sampleRacingLine(const RacingLine& line, float distance, float& x, float& z, float& speed) {
+    const int n = (int)line.x.size();
+    float u = distance / line.spacing;
+    u -= n * std::floor(u / n);
+    int i = std::min((int)u, n - 1);
+    int next = (i + 1) % n;
+    float t = u - i;
+    x = line.x[i] + (line.x[next] - line.x[i]) * t;
+    z = line.z[i] + (line.z[next] - line.z[i]) * t;
+    speed = line.speed[i] + (line.speed[next] - line.speed[i]) * t;
+}
+
+static float distanceSq(const RacingLine& line, int i, float x, float z) {
+    float dx = line.x[i] - x, dz = line.z[i] - z;
+    return dx * dx + dz * dz;
+}
+
+void resetAiDrivers(AiDrivers& ai, const RacingLine& line, const VehicleSet& set) {
+    ai.lineIndex.assign(set.count, 0);
+    ai.reverseTicks.assign(set.count, 0);
+    const int n = (int)line.x.size();
+    for (int i = 0; i < set.count; i++) {
+        // Nearest sample the car is facing along; where the track crosses
+        // itself the nearest one overall can be on the other road
+        float a = set.angle[i] * M_PI_F / 180.0f;
+        float hx = sinf(a), hz = cosf(a);
+        float best = FLT_MAX, bestAny = FLT_MAX;
+        int index = 0, indexAny = 0;
+        for (int j = 0; j < n; j++) {
+            float d = distanceSq(line, j, set.x[i], set.z[i]);
+            if (d < bestAny) {
+                bestAny = d;
+                indexAny = j;
+            }
+            int next = (j + 1) % n;
+            float dx = line.x[next] - line.x[j], dz = line.z[next] - line.z[j];
+            if (d < best && dx * hx + dz * hz > 0.5f * sqrtf(dx * dx + dz * dz)) {
+                best = d;
+                index = j;
+            }
+        }
+        ai.lineIndex[i] = best < FLT_MAX ? index : indexAny;
+    }
+}
+
+// Centerline distance of (x, z): the nearest sample in a window around
+// index (a window, not a walk downhill, so a hairpin's tip does not trap
+// cars on the far leg), then projected onto the segment on the car's side.
+static float trackLineProgress(const RacingLine& line, int& index, float x, float z) {
+    const int n = (int)line.x.size();
+    int start = index;
+    float best = FLT_MAX;
+    for (int k = -AI_SEARCH_BEHIND; k <= AI_SEARCH_AHEAD; k++) {
+        int j = (start + k + n) % n;
+        float d = distanceSq(line, j, x, z);
+        if (d < best) {
+            best = d;
+            index = j;
+        }
+    }
+
+    int after = (index + 1) % n, before = (index + n - 1) % n;
+    float sx = line.x[after] - line.x[index], sz = line.z[after] - line.z[index];
+    float t = ((x - line.x[index]) * sx + (z - line.z[index]) * sz) / (sx * sx + sz * sz);
+    if (t < 0.0f) {
+        sx = line.x[index] - line.x[before];
+        sz = line.z[index] - line.z[before];
+        t = ((x - line.x[before]) * sx + (z - line.z[before]) * sz) / (sx * sx + sz * sz) - 1.0f;
+        t = std::max(t, -1.0f);
+    }
+    return (index + std::min(t, 1.0f)) * line.spacing;
+}
+
+void driveAiCars(const RacingLine& line, AiDrivers& ai, VehicleSet& set, int first, int last) {
+    if (line.x.empty()) return;
+
+    for (int i = first; i < last; i++) {
+        float speed = set.speed[i];
+        float progress = trackLineProgress(line, ai.lineIndex[i], set.x[i], set.z[i]);
+
+        // --- Steering: turn towards the line ahead ---
+        // Where the line folds back on itself (hairpins) a point further
+        // along it can still be next to the car; walk on until it is not.
+        float lookahead = AI_LOOKAHEAD + AI_LOOKAHEAD_TIME * std::fabs(speed);
+        float tx, tz, unused, dx, dz;
+        float along = progress + lookahead;
+        for (int step = 0; step < AI_LOOKAHEAD_STEPS; step++) {
+            sampleRacingLine(line, along, tx, tz, unused);
+            dx = tx - set.x[i];
+            dz = tz - set.z[i];
+            if (dx * dx + dz * dz >= lookahead * lookahead) break;
+            along += line.spacing;
+        }
+        float a = set.angle[i] * M_PI_F / 180.0f;
+        float sn = sinf(a), cs = cosf(a);
+        float ahead = dx * sn + dz * cs;
+        float side = dx * cs - dz * sn;   // > 0: the target is to the left
+        float steer = 0.0f;
+        if (ahead <= 0.0f) steer = side >= 0.0f ? 1.0f : -1.0f;
+        else if (std::fabs(side) > AI_STEER_DEADBAND * ahead) steer = side > 0.0f ? 1.0f : -1.0f;
+        set.steer[i] = steer;
+
+        // --- Throttle: hold the line's speed where the car is ---
+        float lx, lz, target;
+        sampleRacingLine(line, progress + speed * AI_BRAKE_LEAD_TIME, lx, lz, target);
+        // More than 45 degrees off the nose: turn at a crawl, where the
+        // turning circle is too small to orbit the target
+        if (std::fabs(side) > ahead) target = std::min(target, AI_TURN_SPEED);
+        float throttle = 0.0f;
+        if (speed < target - AI_SPEED_DEADBAND) throttle = 1.0f;
+        else if (speed > target + AI_SPEED_DEADBAND) throttle = -1.0f;
+        set.throttle[i] = throttle;
+
+        // --- Recovery: stopped against scenery, back off while turning ---
+        // (stopped again while backing off: something behind, so go on)
+        if (set.colliding[i] && std::fabs(speed) < AI_TURN_SPEED) {
+            ai.reverseTicks[i] = ai.reverseTicks[i] > 0 ? 0 : AI_REVERSE_TICKS;
+        }
+        if (ai.reverseTicks[i] > 0) {
+            ai.reverseTicks[i]--;
+            set.throttle[i] = -1.0f;
+        }
+    }
+}
+
+void driveAiCarsParallel(ThreadPool& pool, const RacingLine& line, AiDrivers& ai,
+    VehicleSet& set, int first) {
+    parallelFor(pool, set.count - first, AI_CARS_PER_TASK, [&](int begin, int end) {
+        driveAiCars(line, ai, set, first + begin, first + end);
+    });
+}
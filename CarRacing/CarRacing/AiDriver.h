@@ -0,0 +1,75 @@
+#ifndef AIDRIVER_H
+#define AIDRIVER_H
+
+#include "ThreadPool.h"
+#include "TrackSpline.h"
+#include "Vehicles.h"
+#include <vector>
+
+// AI opponents. A racing line (a smoothed path inside the track edges with
+// a target speed at every point) is computed once per track; each tick the
+// drivers only look it up: locate the car on the centerline, read the line
+// a speed-dependent distance ahead, and set throttle and steering in the
+// VehicleSet. Cars are independent, so the tick is split across a worker
+// pool. GL-free.
+
+// ===== Racing Line =====
+const float RACING_LINE_SPACING = 2.0f;    // along the centerline between samples
+const float RACING_LINE_MARGIN = 3.5f;     // kept from each track edge
+const int RACING_LINE_ITERATIONS = 400;    // smoothing passes
+const float AI_CORNER_GRIP = 0.8f;         // share of the full steering rate used in corners
+const float AI_MIN_CORNER_SPEED = 4.0f;    // hairpins: turns on the spot inside the track width
+
+// ===== Driver =====
+const float AI_LOOKAHEAD = 3.0f;           // steering target distance when stopped
+const float AI_LOOKAHEAD_TIME = 0.15f;     // seconds of travel added to it
+const int AI_LOOKAHEAD_STEPS = 16;         // line samples searched for a target that far away
+const int AI_SEARCH_BEHIND = 2;            // line samples checked each tick around the last one
+const int AI_SEARCH_AHEAD = 8;
+const float AI_STEER_DEADBAND = 0.02f;     // target side/ahead offset (tangent of its bearing) before steering
+const float AI_SPEED_DEADBAND = 0.5f;      // coast within this of the target speed
+const float AI_BRAKE_LEAD_TIME = 0.1f;     // seconds ahead the target speed is read
+const float AI_TURN_SPEED = 2.0f;          // while the target is far off the nose
+const int AI_REVERSE_TICKS = 60;           // backing off scenery the car is stuck against
+const int AI_CARS_PER_TASK = 64;           // cars each pool task drives
+
+struct RacingLine {
+    float spacing = RACING_LINE_SPACING;   // adjusted so whole steps close the loop
+    float totalLength = 0.0f;              // centerline length
+    std::vector<float> x, z;               // line point at each centerline sample
+    std::vector<float> offset;             // from the centerline, > 0 towards +(-tz, tx)
+    std::vector<float> speed;              // target speed at each sample
+};
+
+// Builds the line from the centerline: lateral offsets are relaxed towards
+// the straightest path that stays RACING_LINE_MARGIN inside the edges, each
+// point gets the fastest speed its curvature allows at the car's steering
+// rate, and a backward pass lowers speeds so braking at ACCELERATION is
+// always enough for the next corner.
+void buildRacingLine(RacingLine& line, const TrackSpline& spline, float spacing = RACING_LINE_SPACING);
+
+// Line point and target speed at a centerline distance (wraps around).
+void sampleRacingLine(const RacingLine& line, float distance, float& x, float& z, float& speed);
+
+// Per-car driver state: where on the line each car was last tick. Searching
+// the line near there keeps a car on its own stretch where the track passes
+// close to itself, and costs a few distance checks instead of a track query.
+struct AiDrivers {
+    std::vector<int> lineIndex;            // nearest racing line sample
+    std::vector<int> reverseTicks;         // left to back off for; 0 when driving
+};
+
+// Locates every car of set on the line from scratch. Call after placing the
+// cars or changing their count.
+void resetAiDrivers(AiDrivers& ai, const RacingLine& line, const VehicleSet& set);
+
+// Sets throttle and steer for cars [first, last) of set. A car that
+// set.colliding shows stopped against scenery reverses for a while first.
+void driveAiCars(const RacingLine& line, AiDrivers& ai, VehicleSet& set, int first, int last);
+
+// driveAiCars() for cars [first, set.count), AI_CARS_PER_TASK per task on
+// pool (inline when the pool has no workers).
+void driveAiCarsParallel(ThreadPool& pool, const RacingLine& line, AiDrivers& ai,
+    VehicleSet& set, int first);
+
+#endif // AIDRIVER_H
@@ -0,0 +1,16 @@
+#include "AtomicFile.h"
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+bool replaceFileAtomically(const char* tmpPath, const char* path) {
+#ifdef _WIN32
+    // rename() won't replace an existing file on Windows
+    return MoveFileExA(tmpPath, path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    // rename() replaces path atomically on POSIX
+    return rename(tmpPath, path) == 0;
+#endif
+}
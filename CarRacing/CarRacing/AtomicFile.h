@@ -0,0 +1,12 @@
+#ifndef ATOMICFILE_H
+#define ATOMICFILE_H
+
+// Finishing a file written to a temporary path: the temporary replaces
+// path in one step, so a reader (or a crash) sees either the old file or
+// the complete new one, never a half-written or missing one. GL-free.
+
+// Moves tmpPath over path, replacing any file there. Returns false (and
+// leaves path as it was) on failure; tmpPath is then still the caller's.
+bool replaceFileAtomically(const char* tmpPath, const char* path);
+
+#endif // ATOMICFILE_H
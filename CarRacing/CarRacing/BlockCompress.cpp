@@ -0,0 +1,165 @@
+#include "BlockCompress.h"
+
+// ===== Helpers =====
+static unsigned short packRgb565(const int c[3]) {
+    return (unsigned short)(((c[0] >> 3) << 11) | ((c[1] >> 2) << 5) | (c[2] >> 3));
+}
+
+static void unpackRgb565(unsigned short v, int c[3]) {
+    int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+    c[0] = (r << 3) | (r >> 2);
+    c[1] = (g << 2) | (g >> 4);
+    c[2] = (b << 3) | (b >> 2);
+}
+
+static void writeLe16(unsigned char* out, unsigned int v) {
+    out[0] = (unsigned char)v;
+    out[1] = (unsigned char)(v >> 8);
+}
+
+// 4x4 texels starting at (x, y), clamped at the level edge for levels
+// smaller than a block
+static void fetchBlock(const TextureLevel& level, int x, int y, unsigned char block[64]) {
+    for (int j = 0; j < 4; j++) {
+        int sy = y + j < level.height ? y + j : level.height - 1;
+        for (int i = 0; i < 4; i++) {
+            int sx = x + i < level.width ? x + i : level.width - 1;
+            const unsigned char* texel = &level.data[((size_t)sy * level.width + sx) * 4];
+            for (int c = 0; c < 4; c++) block[(j * 4 + i) * 4 + c] = texel[c];
+        }
+    }
+}
+
+// ===== Color Block =====
+// Always four-color mode (c0 > c1), as BC3 requires.
+static void encodeColorBlock(const unsigned char block[64], unsigned char out[8]) {
+    int lo[3] = { 255, 255, 255 }, hi[3] = { 0, 0, 0 };
+    for (int t = 0; t < 16; t++) {
+        for (int c = 0; c < 3; c++) {
+            int v = block[t * 4 + c];
+            if (v < lo[c]) lo[c] = v;
+            if (v > hi[c]) hi[c] = v;
+        }
+    }
+
+    // Pull the endpoints in by 1/16 of the range: the box corners are
+    // rarely texels themselves and the inset lowers the average error
+    for (int c = 0; c < 3; c++) {
+        int inset = (hi[c] - lo[c]) >> 4;
+        lo[c] += inset;
+        hi[c] -= inset;
+    }
+
+    // lo-hi is only one of the box's four diagonals. Follow the colors
+    // instead: a channel that falls while the widest one rises runs from
+    // its hi to its lo end.
+    int axis = 0;
+    for (int c = 1; c < 3; c++) {
+        if (hi[c] - lo[c] > hi[axis] - lo[axis]) axis = c;
+    }
+    int mean[3] = { 0, 0, 0 };
+    for (int t = 0; t < 16; t++) {
+        for (int c = 0; c < 3; c++) mean[c] += block[t * 4 + c];
+    }
+    for (int c = 0; c < 3; c++) mean[c] = (mean[c] + 8) >> 4;
+    for (int c = 0; c < 3; c++) {
+        if (c == axis) continue;
+        int covariance = 0;
+        for (int t = 0; t < 16; t++) {
+            covariance += (block[t * 4 + c] - mean[c]) * (block[t * 4 + axis] - mean[axis]);
+        }
+        if (covariance < 0) {
+            int swap = lo[c]; lo[c] = hi[c]; hi[c] = swap;
+        }
+    }
+
+    unsigned short c0 = packRgb565(hi), c1 = packRgb565(lo);
+    unsigned int indices = 0;
+    if (c0 < c1) {
+        unsigned short swap = c0; c0 = c1; c1 = swap;
+    }
+    if (c0 != c1) {
+        int palette[4][3];
+        unpackRgb565(c0, palette[0]);
+        unpackRgb565(c1, palette[1]);
+        for (int c = 0; c < 3; c++) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        for (int t = 0; t < 16; t++) {
+            int best = 0, bestError = 1 << 30;
+            for (int p = 0; p < 4; p++) {
+                int dr = block[t * 4] - palette[p][0];
+                int dg = block[t * 4 + 1] - palette[p][1];
+                int db = block[t * 4 + 2] - palette[p][2];
+                int error = dr * dr + dg * dg + db * db;
+                if (error < bestError) { bestError = error; best = p; }
+            }
+            indices |= (unsigned int)best << (t * 2);
+        }
+    }
+
+    writeLe16(out, c0);
+    writeLe16(out + 2, c1);
+    writeLe16(out + 4, indices & 0xFFFF);
+    writeLe16(out + 6, indices >> 16);
+}
+
+// ===== Alpha Block =====
+// Eight-value mode (a0 > a1); a flat block uses index 0 everywhere.
+static void encodeAlphaBlock(const unsigned char block[64], unsigned char out[8]) {
+    int lo = 255, hi = 0;
+    for (int t = 0; t < 16; t++) {
+        int a = block[t * 4 + 3];
+        if (a < lo) lo = a;
+        if (a > hi) hi = a;
+    }
+
+    unsigned long long indices = 0;
+    if (hi != lo) {
+        int palette[8];
+        palette[0] = hi;
+        palette[1] = lo;
+        for (int i = 2; i < 8; i++) palette[i] = ((8 - i) * hi + (i - 1) * lo) / 7;
+        for (int t = 0; t < 16; t++) {
+            int a = block[t * 4 + 3];
+            int best = 0, bestError = 256;
+            for (int p = 0; p < 8; p++) {
+                int error = a > palette[p] ? a - palette[p] : palette[p] - a;
+                if (error < bestError) { bestError = error; best = p; }
+            }
+            indices |= (unsigned long long)best << (t * 3);
+        }
+    }
+
+    out[0] = (unsigned char)hi;
+    out[1] = (unsigned char)lo;
+    for (int i = 0; i < 6; i++) out[2 + i] = (unsigned char)(indices >> (i * 8));
+}
+
+// ===== Images =====
+void compressTextureImage(TextureImage& image, TextureFormat format) {
+    if (image.format != TEXTURE_RGBA8 || format == TEXTURE_RGBA8) return;
+    size_t blockBytes = format == TEXTURE_BC1 ? 8 : 16;
+
+    for (TextureLevel& level : image.levels) {
+        std::vector<unsigned char> blocks(textureLevelSize(format, level.width, level.height));
+        unsigned char* out = blocks.data();
+        unsigned char block[64];
+        for (int y = 0; y < level.height; y += 4) {
+            for (int x = 0; x < level.width; x += 4) {
+                fetchBlock(level, x, y, block);
+                if (format == TEXTURE_BC3) {
+                    encodeAlphaBlock(block, out);
+                    encodeColorBlock(block, out + 8);
+                }
+                else {
+                    encodeColorBlock(block, out);
+                }
+                out += blockBytes;
+            }
+        }
+        level.data.swap(blocks);
+    }
+    image.format = format;
+}
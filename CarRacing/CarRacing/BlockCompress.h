@@ -0,0 +1,16 @@
+#ifndef BLOCKCOMPRESS_H
+#define BLOCKCOMPRESS_H
+
+#include "TextureImage.h"
+
+// BC1/BC3 (DXT1/DXT5) encoder for baked textures. Endpoints are the ends
+// of the block's color bounding box diagonal that the colors run along,
+// inset slightly, and each texel takes the nearest palette entry - fast
+// enough to run on first launch, and close to what offline tools produce
+// for photographic textures. GL-free.
+
+// Encodes every level of an RGBA8 image in place. format is TEXTURE_BC1
+// (alpha dropped) or TEXTURE_BC3.
+void compressTextureImage(TextureImage& image, TextureFormat format);
+
+#endif // BLOCKCOMPRESS_H
@@ -0,0 +1,141 @@
+#include "CarMesh.h"
+#include "Primitives.h"
+
+// Slices per LOD for the wheel cylinders/disks; slices and stacks for the
+// helmet. Level 0 matches the original GLU calls.
+static const int wheelSlices[CAR_LOD_LEVELS] = { 32, 16, 8 };
+static const int helmetTessellation[CAR_LOD_LEVELS][2] = {
+    { 32, 16 },
+    { 16, 8 },
+    { 8, 4 },
+};
+static const int noseTessellation[CAR_LOD_LEVELS][2] = {
+    { 16, 16 },
+    { 8, 2 },
+    { 6, 1 },
+};
+
+struct CarWheel {
+    float x, z;
+    float radius, width;
+};
+static const float CAR_WHEEL_Y = 0.7f;
+static const CarWheel carWheels[CAR_WHEELS] = {
+    { 1.0f, 1.7f, 0.65f, 0.5f },
+    { -1.5f, 1.7f, 0.65f, 0.5f },
+    { 0.8f, -1.8f, 0.65f, 0.7f },
+    { -1.5f, -1.8f, 0.65f, 0.7f },
+};
+
+void buildWheelMeshes(int lod, int spokes, Mesh& tread, Mesh& body) {
+    int slices = wheelSlices[lod];
+
+    // --- Tread (textured, untinted) ---
+    tread.primitive = MESH_TRIANGLES;
+    tread.useVertexColor = true;
+    tread.vertices.clear();
+    appendCylinder(tread, MeshTransform(), 1.0f, 1.0f, 1.0f, slices, 1);
+
+    // --- Side disks (black) ---
+    body.primitive = MESH_TRIANGLES;
+    body.useVertexColor = true;
+    body.vertices.clear();
+    appendDisk(body, MeshTransform(), 0.0f, 1.0f, slices, 1, 0.05f, 0.05f, 0.05f);
+    appendDisk(body, MeshTransform().translate(0.0f, 0.0f, 1.0f), 0.0f, 1.0f, slices, 1,
+        0.05f, 0.05f, 0.05f);
+
+    // --- Alloy hub (white) in the middle of the tire ---
+    float hubRadius = 0.5f;
+    float hubThickness = 0.2f;
+    MeshTransform hub;
+    hub.translate(0.0f, 0.0f, 0.5f);
+    appendDisk(body, hub, 0.0f, hubRadius, slices, 1);
+
+    if (lod == CAR_LOD_LEVELS - 1) return;
+    for (int i = 0; i < spokes; i++) {
+        MeshTransform spoke = hub;
+        spoke.rotate(i * 360.0f / spokes, 0.0f, 0.0f, 1.0f);
+        spoke.translate(hubRadius * 0.5f, 0.0f, 0.0f);
+        spoke.scale(hubRadius * 0.5f, hubRadius * 0.05f, hubThickness);
+        appendBox(body, spoke);
+    }
+}
+
+void buildHelmetMesh(int lod, Mesh& helmet) {
+    helmet.primitive = MESH_TRIANGLES;
+    helmet.useVertexColor = true;
+    helmet.vertices.clear();
+    appendSphere(helmet, MeshTransform(), 0.25f,
+        helmetTessellation[lod][0], helmetTessellation[lod][1]);
+}
+
+// Unit cube with the texture laid out as the car's old immediate-mode box:
+// the sides match appendBox(), the top and bottom are turned.
+static void appendLiveryBox(Mesh& mesh, const MeshTransform& xf) {
+    static const float faces[6][3] = {
+        { 0, 0, 1 }, { 0, 0, -1 }, { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 },
+    };
+    // x, y, z, u, v per corner
+    static const float corners[6][4][5] = {
+        { { -0.5f, -0.5f, 0.5f, 0, 0 }, { 0.5f, -0.5f, 0.5f, 1, 0 }, { 0.5f, 0.5f, 0.5f, 1, 1 }, { -0.5f, 0.5f, 0.5f, 0, 1 } },
+        { { -0.5f, -0.5f, -0.5f, 1, 0 }, { -0.5f, 0.5f, -0.5f, 1, 1 }, { 0.5f, 0.5f, -0.5f, 0, 1 }, { 0.5f, -0.5f, -0.5f, 0, 0 } },
+        { { 0.5f, -0.5f, 0.5f, 0, 0 }, { 0.5f, -0.5f, -0.5f, 1, 0 }, { 0.5f, 0.5f, -0.5f, 1, 1 }, { 0.5f, 0.5f, 0.5f, 0, 1 } },
+        { { -0.5f, -0.5f, 0.5f, 1, 0 }, { -0.5f, 0.5f, 0.5f, 1, 1 }, { -0.5f, 0.5f, -0.5f, 0, 1 }, { -0.5f, -0.5f, -0.5f, 0, 0 } },
+        { { -0.5f, 0.5f, 0.5f, 0, 1 }, { 0.5f, 0.5f, 0.5f, 0, 0 }, { 0.5f, 0.5f, -0.5f, 1, 0 }, { -0.5f, 0.5f, -0.5f, 1, 1 } },
+        { { -0.5f, -0.5f, 0.5f, 1, 1 }, { 0.5f, -0.5f, 0.5f, 0, 1 }, { 0.5f, -0.5f, -0.5f, 0, 0 }, { -0.5f, -0.5f, -0.5f, 1, 0 } },
+    };
+    static const int quadToTriangles[6] = { 0, 1, 2, 0, 2, 3 };
+
+    mesh.vertices.reserve(mesh.vertices.size() + 36);
+    for (int f = 0; f < 6; f++) {
+        for (int k : quadToTriangles) {
+            const float* c = corners[f][k];
+            float x = c[0], y = c[1], z = c[2];
+            float nx = faces[f][0], ny = faces[f][1], nz = faces[f][2];
+            xf.transformPoint(x, y, z);
+            xf.transformNormal(nx, ny, nz);
+            mesh.vertices.push_back(makeVertex(x, y, z, nx, ny, nz, c[3], c[4]));
+        }
+    }
+}
+
+void buildCarBodyMeshes(int lod, Mesh& paint, Mesh& trim) {
+    paint.primitive = MESH_TRIANGLES;
+    paint.useVertexColor = true;
+    paint.vertices.clear();
+    trim.primitive = MESH_TRIANGLES;
+    trim.useVertexColor = true;
+    trim.vertices.clear();
+
+    // --- Painted: body, front and rear wings, nose cone ---
+    appendLiveryBox(paint, MeshTransform().translate(0.0f, 1.0f, 0.0f).scale(1.2f, 0.7f, 4.0f));
+    appendLiveryBox(paint, MeshTransform().translate(0.0f, 0.95f, 3.0f).scale(2.0f, 0.1f, 0.4f));
+    appendLiveryBox(paint, MeshTransform().translate(0.0f, 1.85f, -2.2f).scale(1.8f, 0.1f, 0.3f));
+    appendCylinder(paint, MeshTransform().translate(0.0f, 1.0f, 2.0f), 0.3f, 0.1f, 1.5f,
+        noseTessellation[lod][0], noseTessellation[lod][1]);
+
+    // --- Trim ---
+    appendBox(trim, MeshTransform().translate(0.0f, 1.1f, -0.5f).scale(0.8f, 0.6f, 1.0f),
+        0.1f, 0.1f, 0.1f); // cockpit
+    for (int side = -1; side <= 1; side += 2) {
+        appendBox(trim, MeshTransform().translate(side * 0.3f, 1.5f, -2.2f).scale(0.1f, 0.8f, 0.1f),
+            0.3f, 0.5f, 0.05f); // rear wing support
+        appendBox(trim, MeshTransform().translate(side * 1.05f, 0.95f, 3.0f).scale(0.05f, 0.5f, 0.3f),
+            0.0f, 0.0f, 0.0f); // front wing endplate
+    }
+    for (const CarWheel& w : carWheels) {
+        MeshTransform arm;
+        arm.translate(w.x * 0.7f, CAR_WHEEL_Y + 0.2f, w.z * 0.9f);
+        arm.rotate(90.0f, 0.0f, 1.0f, 0.0f);
+        arm.scale(0.2f, 0.1f, 0.8f);
+        appendBox(trim, arm, 0.1f, 0.1f, 0.1f); // suspension arm
+    }
+}
+
+void carWheelTransform(MeshTransform& xf, int wheel, float spinDeg) {
+    const CarWheel& w = carWheels[wheel];
+    xf.translate(w.x, CAR_WHEEL_Y, w.z);
+    xf.rotate(spinDeg, 1.0f, 0.0f, 0.0f);
+    xf.rotate(90.0f, 0.0f, 1.0f, 0.0f); // wheel axis along the car's X
+    xf.scale(w.radius, w.radius, w.width);
+}
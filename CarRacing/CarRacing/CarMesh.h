@@ -0,0 +1,39 @@
+#ifndef CARMESH_H
+#define CARMESH_H
+
+#include "Lod.h"
+#include "Mesh.h"
+
+// Precomputed levels of the car model. The round parts were tessellated
+// with GLU at 32 slices regardless of distance, and the body was rebuilt in
+// immediate mode every frame.
+
+const int CAR_LOD_LEVELS = 3;
+const LodDistances CAR_LOD = { CAR_LOD_LEVELS, { 25.0f, 60.0f }, 0.1f };
+
+// Wheel of radius 1 and width 1 along +Z, as drawWheel() lays it out after
+// its 90 degree turn; scale by (radius, radius, width) to place it.
+// tread is the textured outer cylinder, body the black side disks plus the
+// white hub and spokes (spokes are left out at the coarsest level).
+void buildWheelMeshes(int lod, int spokes, Mesh& tread, Mesh& body);
+
+// Textured helmet sphere of radius 0.25 around the origin. It sits at
+// (0, CAR_HELMET_Y, CAR_HELMET_Z) in the car's frame.
+void buildHelmetMesh(int lod, Mesh& helmet);
+const float CAR_HELMET_Y = 1.5f;
+const float CAR_HELMET_Z = -0.6f;
+
+// ===== Car Body =====
+// Everything but the wheels and the helmet, in the car's frame (origin on
+// the ground under its centre, nose along +Z). paint is the body, wings and
+// nose cone, drawn white under the car texture; trim is the untextured
+// cockpit, wing supports, endplates and suspension arms.
+void buildCarBodyMeshes(int lod, Mesh& paint, Mesh& trim);
+
+// Wheels 0-1 are the front pair, 2-3 the rear. Multiplies xf (the car's
+// transform) by the wheel's placement turned spinDeg about its axle, so
+// the buildWheelMeshes() meshes drawn under xf sit on the car.
+const int CAR_WHEELS = 4;
+void carWheelTransform(MeshTransform& xf, int wheel, float spinDeg);
+
+#endif // CARMESH_H
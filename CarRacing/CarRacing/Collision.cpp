@@ -0,0 +1,336 @@
+#include "Collision.h"
+#include "Scenery.h"
+#include "TrackQuery.h"
+#include "World.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// Footprints of each TrackObject type around its position, from
+// buildTrackObjectMesh(): the tire stack torus, barrier box, lamp post and
+// banner box.
+static const float trackObjectHalfExtents[TRACK_OBJECT_TYPES][2] = {
+    { 0.55f, 0.55f },
+    { 1.0f, 0.25f },
+    { 0.05f, 0.05f },
+    { 2.0f, 0.1f },
+};
+
+// Scenery reaching closer than this to the centerline is not solid
+static const float SOLID_LATERAL_MIN = TRACK_WIDTH * 0.5f - 2.0f;
+
+static Collider makeCollider(int kind, int index, float x, float z, float halfX, float halfZ) {
+    Collider c;
+    c.minX = x - halfX; c.maxX = x + halfX;
+    c.minZ = z - halfZ; c.maxZ = z + halfZ;
+    c.kind = kind;
+    c.index = index;
+    return c;
+}
+
+// Whether c reaches out onto the racing surface, judged at points around
+// its outline a quarter track width apart. The generator places scenery
+// relative to one edge at a time, so inside tight corners and where the
+// track passes close to itself things land on the tarmac (edge stacks where
+// an edge folds over itself, objects and stands pushed in from the other
+// side); those stay scenery only, or they would wall the track off.
+static bool onRacingSurface(const TrackIndex& track, const Collider& c) {
+    if (track.segments.empty()) return false;
+    const float step = TRACK_WIDTH * 0.25f;
+    int stepsX = (int)std::ceil((c.maxX - c.minX) / step);
+    int stepsZ = (int)std::ceil((c.maxZ - c.minZ) / step);
+    for (int i = 0; i <= stepsX; i++) {
+        for (int j = 0; j <= stepsZ; j++) {
+            if (i != 0 && i != stepsX && j != 0 && j != stepsZ) continue;
+            float x = stepsX > 0 ? c.minX + (c.maxX - c.minX) * i / stepsX : c.minX;
+            float z = stepsZ > 0 ? c.minZ + (c.maxZ - c.minZ) * j / stepsZ : c.minZ;
+            if (std::fabs(queryTrack(track, x, z).lateral) < SOLID_LATERAL_MIN) return true;
+        }
+    }
+    return false;
+}
+
+static void addCollider(std::vector<Collider>& colliders, const TrackIndex& track, const Collider& c) {
+    if (!onRacingSurface(track, c)) colliders.push_back(c);
+}
+
+void gatherColliders(std::vector<Collider>& colliders, const TrackIndex& track) {
+    colliders.clear();
+
+    // Edge stacks: the bottom tire of each stack, BARRIER_STACK_HEIGHT
+    // instances apart
+    std::vector<MeshInstance> tires;
+    buildTireBarrierInstances(tires);
+    for (size_t i = 0; i < tires.size(); i += BARRIER_STACK_HEIGHT) {
+        addCollider(colliders, track, makeCollider(COLLIDER_TIRE_STACK, -1, tires[i].x, tires[i].z,
+            BARRIER_TIRE_RADIUS, BARRIER_TIRE_RADIUS));
+    }
+
+    for (size_t i = 0; i < trackObjects.size(); i++) {
+        const TrackObject& o = trackObjects[i];
+        if (o.type < 0 || o.type >= TRACK_OBJECT_TYPES) continue;
+        addCollider(colliders, track, makeCollider(COLLIDER_TIRE_STACK + o.type, (int)i, o.x, o.z,
+            trackObjectHalfExtents[o.type][0], trackObjectHalfExtents[o.type][1]));
+    }
+    for (size_t i = 0; i < stands.size(); i++) {
+        const Stand& s = stands[i];
+        addCollider(colliders, track, makeCollider(COLLIDER_STAND, (int)i, s.x, s.z, s.width * 0.5f, s.depth * 0.5f));
+    }
+    for (size_t i = 0; i < buildings.size(); i++) {
+        const Building& b = buildings[i];
+        addCollider(colliders, track, makeCollider(COLLIDER_BUILDING, (int)i, b.x, b.z, b.width * 0.5f, b.depth * 0.5f));
+    }
+}
+
+// Cells covered by [minX, maxX] x [minZ, maxZ], clamped to the grid
+static void cellRange(const CollisionWorld& world, float minX, float minZ, float maxX, float maxZ,
+    int& x0, int& z0, int& x1, int& z1) {
+    x0 = std::max((int)std::floor((minX - world.originX) / world.cellSize), 0);
+    z0 = std::max((int)std::floor((minZ - world.originZ) / world.cellSize), 0);
+    x1 = std::min((int)std::floor((maxX - world.originX) / world.cellSize), world.cellsX - 1);
+    z1 = std::min((int)std::floor((maxZ - world.originZ) / world.cellSize), world.cellsZ - 1);
+}
+
+void buildCollisionWorld(CollisionWorld& world, const TrackIndex& track, float cellSize) {
+    gatherColliders(world.colliders, track);
+    buildCollisionGrid(world, cellSize);
+}
+
+void buildCollisionGrid(CollisionWorld& world, float cellSize) {
+    world.cellSize = cellSize;
+    world.cellStart.clear();
+    world.cellItems.clear();
+
+    if (world.colliders.empty()) {
+        world.cellsX = world.cellsZ = 0;
+        world.cellStart.push_back(0);
+        return;
+    }
+
+    float minX = FLT_MAX, minZ = FLT_MAX, maxX = -FLT_MAX, maxZ = -FLT_MAX;
+    for (const Collider& c : world.colliders) {
+        minX = std::min(minX, c.minX); maxX = std::max(maxX, c.maxX);
+        minZ = std::min(minZ, c.minZ); maxZ = std::max(maxZ, c.maxZ);
+    }
+    world.originX = minX;
+    world.originZ = minZ;
+    world.cellsX = (int)((maxX - minX) / cellSize) + 1;
+    world.cellsZ = (int)((maxZ - minZ) / cellSize) + 1;
+    int cellCount = world.cellsX * world.cellsZ;
+
+    // Counting sort, with every collider in each cell it overlaps
+    world.cellStart.assign(cellCount + 1, 0);
+    for (const Collider& c : world.colliders) {
+        int x0, z0, x1, z1;
+        cellRange(world, c.minX, c.minZ, c.maxX, c.maxZ, x0, z0, x1, z1);
+        for (int iz = z0; iz <= z1; iz++) {
+            for (int ix = x0; ix <= x1; ix++) world.cellStart[iz * world.cellsX + ix + 1]++;
+        }
+    }
+    for (int c = 0; c < cellCount; c++) world.cellStart[c + 1] += world.cellStart[c];
+
+    std::vector<int> fill(world.cellStart.begin(), world.cellStart.end() - 1);
+    world.cellItems.resize(world.cellStart[cellCount]);
+    for (size_t i = 0; i < world.colliders.size(); i++) {
+        const Collider& c = world.colliders[i];
+        int x0, z0, x1, z1;
+        cellRange(world, c.minX, c.minZ, c.maxX, c.maxZ, x0, z0, x1, z1);
+        for (int iz = z0; iz <= z1; iz++) {
+            for (int ix = x0; ix <= x1; ix++) world.cellItems[fill[iz * world.cellsX + ix]++] = (int)i;
+        }
+    }
+}
+
+bool carOverlapsCollider(const Collider& c, float x, float z, float angle, float& pushX, float& pushZ) {
+    // Car axes: forward (fx, fz), right (fz, -fx)
+    float a = angle * M_PI_F / 180.0f;
+    float fx = sinf(a), fz = cosf(a);
+    float cx = x + fx * CAR_BOX_CENTER_Z, cz = z + fz * CAR_BOX_CENTER_Z;
+
+    float ex = (c.maxX - c.minX) * 0.5f, ez = (c.maxZ - c.minZ) * 0.5f;
+    float dx = cx - (c.minX + ex), dz = cz - (c.minZ + ez);
+
+    // Overlap along each of the four candidate separating axes; the
+    // smallest is the way out
+    float carX = CAR_BOX_HALF_WIDTH * std::fabs(fz) + CAR_BOX_HALF_LENGTH * std::fabs(fx);
+    float carZ = CAR_BOX_HALF_WIDTH * std::fabs(fx) + CAR_BOX_HALF_LENGTH * std::fabs(fz);
+    float boxForward = ex * std::fabs(fx) + ez * std::fabs(fz);
+    float boxRight = ex * std::fabs(fz) + ez * std::fabs(fx);
+    float alongForward = dx * fx + dz * fz;
+    float alongRight = dx * fz - dz * fx;
+
+    float overlapX = ex + carX - std::fabs(dx);
+    float overlapZ = ez + carZ - std::fabs(dz);
+    float overlapForward = boxForward + CAR_BOX_HALF_LENGTH - std::fabs(alongForward);
+    float overlapRight = boxRight + CAR_BOX_HALF_WIDTH - std::fabs(alongRight);
+    if (overlapX <= 0.0f || overlapZ <= 0.0f || overlapForward <= 0.0f || overlapRight <= 0.0f) return false;
+
+    float best = overlapX;
+    pushX = dx < 0.0f ? -overlapX : overlapX;
+    pushZ = 0.0f;
+    if (overlapZ < best) {
+        best = overlapZ;
+        pushX = 0.0f;
+        pushZ = dz < 0.0f ? -overlapZ : overlapZ;
+    }
+    if (overlapForward < best) {
+        best = overlapForward;
+        float s = alongForward < 0.0f ? -overlapForward : overlapForward;
+        pushX = fx * s;
+        pushZ = fz * s;
+    }
+    if (overlapRight < best) {
+        float s = alongRight < 0.0f ? -overlapRight : overlapRight;
+        pushX = fz * s;
+        pushZ = -fx * s;
+    }
+    return true;
+}
+
+// Takes the speed into a surface with normal (nx, nz) off a car heading
+// (fx, fz), bouncing back by COLLISION_RESTITUTION; sliding along it is
+// kept
+static void takeImpact(CarState& car, float fx, float fz, float nx, float nz) {
+    float facing = (fx * nx + fz * nz) / sqrtf(nx * nx + nz * nz);
+    if (car.speed * facing < 0.0f) {
+        car.speed -= (1.0f + COLLISION_RESTITUTION) * car.speed * std::fabs(facing);
+    }
+}
+
+int collideCar(const CollisionWorld& world, CarState& car) {
+    if (world.cellsX == 0) return 0;
+
+    // Bounds of the turned car box, for the cells and a cheap first test
+    float a = car.angle * M_PI_F / 180.0f;
+    float fx = sinf(a), fz = cosf(a);
+    float cx = car.x + fx * CAR_BOX_CENTER_Z, cz = car.z + fz * CAR_BOX_CENTER_Z;
+    float halfX = CAR_BOX_HALF_WIDTH * std::fabs(fz) + CAR_BOX_HALF_LENGTH * std::fabs(fx);
+    float halfZ = CAR_BOX_HALF_WIDTH * std::fabs(fx) + CAR_BOX_HALF_LENGTH * std::fabs(fz);
+    float minX = cx - halfX, maxX = cx + halfX;
+    float minZ = cz - halfZ, maxZ = cz + halfZ;
+
+    int x0, z0, x1, z1;
+    cellRange(world, minX, minZ, maxX, maxZ, x0, z0, x1, z1);
+
+    int hits = 0;
+    for (int iz = z0; iz <= z1; iz++) {
+        for (int ix = x0; ix <= x1; ix++) {
+            int cell = iz * world.cellsX + ix;
+            for (int k = world.cellStart[cell]; k < world.cellStart[cell + 1]; k++) {
+                const Collider& c = world.colliders[world.cellItems[k]];
+                if (c.maxX < minX || c.minX > maxX || c.maxZ < minZ || c.minZ > maxZ) continue;
+
+                // A collider in several of these cells is handled in the
+                // first one only
+                int cx0, cz0, cx1, cz1;
+                cellRange(world, c.minX, c.minZ, c.maxX, c.maxZ, cx0, cz0, cx1, cz1);
+                if (ix != std::max(cx0, x0) || iz != std::max(cz0, z0)) continue;
+
+                float pushX, pushZ;
+                if (!carOverlapsCollider(c, car.x, car.z, car.angle, pushX, pushZ)) continue;
+                car.x += pushX;
+                car.z += pushZ;
+                hits++;
+                takeImpact(car, fx, fz, pushX, pushZ);
+            }
+        }
+    }
+    return hits;
+}
+
+bool sweepCarBox(const Collider& c, float fromX, float fromZ, float toX, float toZ, float angle,
+    float& t, float& normalX, float& normalZ) {
+    float a = angle * M_PI_F / 180.0f;
+    float fx = sinf(a), fz = cosf(a);
+    float ex = (c.maxX - c.minX) * 0.5f, ez = (c.maxZ - c.minZ) * 0.5f;
+    float sx = fromX + fx * CAR_BOX_CENTER_Z - (c.minX + ex);
+    float sz = fromZ + fz * CAR_BOX_CENTER_Z - (c.minZ + ez);
+    float vx = toX - fromX, vz = toZ - fromZ;
+
+    // The same four axes as carOverlapsCollider(): on each the boxes
+    // overlap for a range of t; the sweep hits where all ranges meet
+    const float axes[4][2] = { { 1.0f, 0.0f }, { 0.0f, 1.0f }, { fx, fz }, { fz, -fx } };
+    float enter = -FLT_MAX, exit = FLT_MAX;
+    for (int k = 0; k < 4; k++) {
+        float nx = axes[k][0], nz = axes[k][1];
+        float reach = CAR_BOX_HALF_WIDTH * std::fabs(fz * nx - fx * nz)
+            + CAR_BOX_HALF_LENGTH * std::fabs(fx * nx + fz * nz)
+            + ex * std::fabs(nx) + ez * std::fabs(nz);
+        float start = sx * nx + sz * nz;
+        float speed = vx * nx + vz * nz;
+        if (std::fabs(speed) < 1e-6f) {
+            if (std::fabs(start) >= reach) return false;
+            continue;
+        }
+        float t0 = (-reach - start) / speed, t1 = (reach - start) / speed;
+        if (t0 > t1) std::swap(t0, t1);
+        if (t0 > enter) {
+            enter = t0;
+            normalX = start < 0.0f ? -nx : nx;
+            normalZ = start < 0.0f ? -nz : nz;
+        }
+        exit = std::min(exit, t1);
+        if (enter >= exit) return false;
+    }
+    if (enter < 0.0f || enter > 1.0f) return false;
+    t = enter;
+    return true;
+}
+
+int sweepCar(const CollisionWorld& world, float fromX, float fromZ, CarState& car) {
+    float moveX = car.x - fromX, moveZ = car.z - fromZ;
+    float length = sqrtf(moveX * moveX + moveZ * moveZ);
+    if (world.cellsX == 0 || length < 1e-4f) return 0;
+
+    // Cells under the whole sweep: the turned box's bounds at both ends
+    float a = car.angle * M_PI_F / 180.0f;
+    float fx = sinf(a), fz = cosf(a);
+    float halfX = CAR_BOX_HALF_WIDTH * std::fabs(fz) + CAR_BOX_HALF_LENGTH * std::fabs(fx);
+    float halfZ = CAR_BOX_HALF_WIDTH * std::fabs(fx) + CAR_BOX_HALF_LENGTH * std::fabs(fz);
+    float cx0 = fromX + fx * CAR_BOX_CENTER_Z, cz0 = fromZ + fz * CAR_BOX_CENTER_Z;
+    float minX = std::min(cx0, cx0 + moveX) - halfX, maxX = std::max(cx0, cx0 + moveX) + halfX;
+    float minZ = std::min(cz0, cz0 + moveZ) - halfZ, maxZ = std::max(cz0, cz0 + moveZ) + halfZ;
+
+    int x0, z0, x1, z1;
+    cellRange(world, minX, minZ, maxX, maxZ, x0, z0, x1, z1);
+
+    float first = FLT_MAX, normalX = 0.0f, normalZ = 0.0f;
+    for (int iz = z0; iz <= z1; iz++) {
+        for (int ix = x0; ix <= x1; ix++) {
+            int cell = iz * world.cellsX + ix;
+            for (int k = world.cellStart[cell]; k < world.cellStart[cell + 1]; k++) {
+                const Collider& c = world.colliders[world.cellItems[k]];
+                if (c.maxX < minX || c.minX > maxX || c.maxZ < minZ || c.minZ > maxZ) continue;
+
+                int cx0, cz0, cx1, cz1;
+                cellRange(world, c.minX, c.minZ, c.maxX, c.maxZ, cx0, cz0, cx1, cz1);
+                if (ix != std::max(cx0, x0) || iz != std::max(cz0, z0)) continue;
+
+                float t, nx, nz;
+                if (!sweepCarBox(c, fromX, fromZ, car.x, car.z, car.angle, t, nx, nz) || t >= first) continue;
+                first = t;
+                normalX = nx;
+                normalZ = nz;
+            }
+        }
+    }
+    if (first == FLT_MAX) return 0;
+
+    // Stop just short of the first contact; the rest of the step is lost
+    float t = std::max(first - COLLISION_SKIN / length, 0.0f);
+    car.x = fromX + moveX * t;
+    car.z = fromZ + moveZ * t;
+    takeImpact(car, fx, fz, normalX, normalZ);
+    return 1;
+}
+
+void collideVehicles(const CollisionWorld& world, const VehicleSet& prev, VehicleSet& set) {
+    const bool swept = prev.count == set.count;
+    for (int i = 0; i < set.count; i++) {
+        CarState car = getVehicle(set, i);
+        int hits = swept ? sweepCar(world, prev.x[i], prev.z[i], car) : 0;
+        hits += collideCar(world, car);
+        if (hits > 0) setVehicle(set, i, car);
+        set.colliding[i] = hits > 0 ? 1 : 0;
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include "Vehicles.h"
+#include <vector>
+
+// Cars against the static scenery. Everything a car can hit (tire stacks
+// along the edges, trackside objects, stands and buildings) stands on the
+// ground axis-aligned, so it is a box on the ground plane; a car is a box
+// turned to its heading. The broad phase is a uniform grid holding every
+// collider in each cell it overlaps, so a car only meets the few colliders
+// in the cells under it however many there are. The narrow phase is a
+// separating-axis test that also gives the shortest way out, with a swept
+// version of it so long steps cannot pass through thin obstacles. GL-free.
+
+enum ColliderKind {
+    COLLIDER_TIRE_STACK,   // the edge barriers and trackside stacks
+    COLLIDER_BARRIER,
+    COLLIDER_LAMP_POST,
+    COLLIDER_BANNER,
+    COLLIDER_STAND,
+    COLLIDER_BUILDING,
+    COLLIDER_KIND_COUNT
+};
+
+struct Collider {
+    float minX, minZ, maxX, maxZ;
+    int kind;   // ColliderKind
+    int index;  // into the matching World.h vector; -1 for edge tire stacks
+};
+
+// ===== Car Box =====
+const float CAR_BOX_HALF_WIDTH = 1.2f;   // wheels and front wing
+const float CAR_BOX_HALF_LENGTH = 2.85f; // rear wheels to front wing
+const float CAR_BOX_CENTER_Z = 0.35f;    // ahead of the car's origin
+
+const float COLLISION_RESTITUTION = 0.3f; // share of the speed into a wall kept, bouncing back
+const float COLLISION_SKIN = 0.01f;       // a swept car stops this short of what it hits
+
+struct CollisionWorld {
+    float originX = 0.0f, originZ = 0.0f;
+    float cellSize = 8.0f;
+    int cellsX = 0, cellsZ = 0;
+
+    std::vector<Collider> colliders;
+    std::vector<int> cellStart;   // colliders of cell c: cellItems[cellStart[c] .. cellStart[c + 1])
+    std::vector<int> cellItems;   // indices into colliders
+};
+
+// Boxes of everything a car can hit, from the generated world. Scenery the
+// generator left on the racing surface (found through track) is skipped.
+void gatherColliders(std::vector<Collider>& colliders, const TrackIndex& track);
+
+// gatherColliders() + buildCollisionGrid(). Call whenever the world or
+// track index is rebuilt.
+void buildCollisionWorld(CollisionWorld& world, const TrackIndex& track, float cellSize = 8.0f);
+
+// Rebuilds the grid over world.colliders.
+void buildCollisionGrid(CollisionWorld& world, float cellSize = 8.0f);
+
+// Narrow phase: whether the car box at (x, z) facing angle (degrees)
+// overlaps c, and if so the shortest push (pushX, pushZ) that separates
+// them.
+bool carOverlapsCollider(const Collider& c, float x, float z, float angle, float& pushX, float& pushZ);
+
+// Pushes a car out of everything it overlaps and takes the speed it had
+// into each collider off (bouncing back by COLLISION_RESTITUTION). Returns
+// the number of colliders hit.
+int collideCar(const CollisionWorld& world, CarState& car);
+
+// Continuous test for a car box moving in a straight line from (fromX,
+// fromZ) to (toX, toZ) at a fixed heading: whether it runs into c, at what
+// fraction t of the move, and the normal of the face it meets. Boxes that
+// already overlap at the start are carOverlapsCollider()'s.
+bool sweepCarBox(const Collider& c, float fromX, float fromZ, float toX, float toZ, float angle,
+    float& t, float& normalX, float& normalZ);
+
+// Sweeps a car that moved from (fromX, fromZ) to where it is now and, if
+// it ran into something on the way, puts it back at the first contact and
+// takes its speed into it. A step longer than a car or a collider is thick
+// would otherwise jump past it or end so deep in that the shortest push
+// comes out of the far side. Returns 1 on a hit, else 0.
+int sweepCar(const CollisionWorld& world, float fromX, float fromZ, CarState& car);
+
+// sweepCar() from each car's position in prev, then collideCar(), for every
+// car, recording set.colliding. prev is the set before the step; with a
+// different car count only the overlap test runs.
+void collideVehicles(const CollisionWorld& world, const VehicleSet& prev, VehicleSet& set);
+
+#endif // COLLISION_H
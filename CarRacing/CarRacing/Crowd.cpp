@@ -0,0 +1,43 @@
+#include "Crowd.h"
+#include "Primitives.h"
+#include <cmath>
+
+void packCrowdInstances(const std::vector<Person>& people, std::vector<CrowdInstance>& instances) {
+    instances.resize(people.size());
+    for (size_t i = 0; i < people.size(); i++) {
+        const Person& p = people[i];
+        CrowdInstance& inst = instances[i];
+        inst.x = p.x;
+        inst.baseY = p.baseY;
+        inst.z = p.z;
+        inst.phase = p.jumpPhase;
+        inst.speed = p.jumpSpeed;
+        inst.r = p.r;
+        inst.g = p.g;
+        inst.b = p.b;
+    }
+}
+
+float crowdJumpOffset(const CrowdInstance& inst, float time) {
+    return sinf(0.1f + inst.phase + inst.speed * CROWD_REFERENCE_FPS * time) * CROWD_JUMP_HEIGHT;
+}
+
+void buildPersonMesh(Mesh& mesh) {
+    mesh.primitive = MESH_TRIANGLES;
+    mesh.useVertexColor = false;
+    mesh.vertices.clear();
+
+    // Body
+    appendBox(mesh, MeshTransform().scale(0.5f, 1.5f, 0.3f));
+
+    // Head
+    appendSphere(mesh, MeshTransform().translate(0.0f, 1.2f, 0.0f), 0.4f, 16, 16);
+
+    // Arms
+    appendBox(mesh, MeshTransform().translate(-0.5f, 0.6f, 0.0f).scale(0.2f, 1.0f, 0.2f));
+    appendBox(mesh, MeshTransform().translate(0.5f, 0.6f, 0.0f).scale(0.2f, 1.0f, 0.2f));
+
+    // Legs
+    appendBox(mesh, MeshTransform().translate(-0.2f, -1.0f, 0.0f).scale(0.25f, 1.2f, 0.25f));
+    appendBox(mesh, MeshTransform().translate(0.2f, -1.0f, 0.0f).scale(0.25f, 1.2f, 0.25f));
+}
@@ -0,0 +1,31 @@
+#ifndef CROWD_H
+#define CROWD_H
+
+#include "Mesh.h"
+#include "World.h"
+#include <vector>
+
+// GL-free side of the crowd renderer: the packed per-spectator record and
+// the shared person mesh. The jump is evaluated from time on the GPU, so
+// nothing here changes per frame.
+
+const float CROWD_JUMP_HEIGHT = 0.5f;
+// Person::jumpSpeed is radians per frame at this rate
+const float CROWD_REFERENCE_FPS = 60.0f;
+
+// Two vec4 attributes: position + phase, speed + color.
+struct CrowdInstance {
+    float x, baseY, z, phase;
+    float speed, r, g, b;
+};
+
+void packCrowdInstances(const std::vector<Person>& people, std::vector<CrowdInstance>& instances);
+
+// Vertical jump offset at time (seconds); the vertex shader computes the same.
+float crowdJumpOffset(const CrowdInstance& inst, float time);
+
+// Body, head, arms and legs around the person's origin, untinted so the
+// instance color applies.
+void buildPersonMesh(Mesh& mesh);
+
+#endif // CROWD_H
@@ -0,0 +1,134 @@
+#include "CrowdRenderer.h"
+#include "Crowd.h"
+#include "GpuMesh.h"
+#include "Shader.h"
+
+// Same reserved attribute range as InstancedMesh.cpp
+static const GLuint CROWD_ATTRIB = 10;
+
+static GLuint crowdProgram = 0;
+static GLint timeLocation = -1;
+static GLint jumpRateLocation = -1;
+static GLint jumpHeightLocation = -1;
+
+static GpuMesh personMesh;
+static GLuint crowdVbo = 0;
+static GLuint visibleVbo = 0;  // per-frame subset after culling
+static GLsizei crowdCount = 0;
+static std::vector<CrowdInstance> crowdCpu; // source for culled subsets and the fallback path
+
+static const char* crowdVertexSource =
+    "#version 120\n"
+    "attribute vec4 crowdPosPhase;\n"
+    "attribute vec4 crowdSpeedColor;\n"
+    "uniform float time;\n"
+    "uniform float jumpRate;\n"
+    "uniform float jumpHeight;\n"
+    "varying vec4 color;\n"
+    GLSL_FIXED_LIGHTING
+    "void main() {\n"
+    "    float jump = sin(0.1 + crowdPosPhase.w + crowdSpeedColor.x * jumpRate * time) * jumpHeight;\n"
+    "    vec3 world = gl_Vertex.xyz + vec3(crowdPosPhase.x, crowdPosPhase.y + jump, crowdPosPhase.z);\n"
+    "    gl_Position = gl_ModelViewProjectionMatrix * vec4(world, 1.0);\n"
+    "    vec3 N = normalize(gl_NormalMatrix * gl_Normal);\n"
+    "    vec3 eyePos = (gl_ModelViewMatrix * vec4(world, 1.0)).xyz;\n"
+    "    color = vec4(crowdSpeedColor.yzw * fixedLighting(N, eyePos), 1.0);\n"
+    "}\n";
+
+static const char* crowdFragmentSource =
+    "#version 120\n"
+    "varying vec4 color;\n"
+    "void main() {\n"
+    "    gl_FragColor = color;\n"
+    "}\n";
+
+void initCrowdRenderer() {
+    Mesh mesh;
+    buildPersonMesh(mesh);
+    uploadMesh(personMesh, mesh);
+
+    if (!glHasInstancing || crowdProgram != 0) return;
+
+    const char* attribs[] = { "crowdPosPhase", "crowdSpeedColor" };
+    crowdProgram = createShaderProgram(crowdVertexSource, crowdFragmentSource,
+        attribs, 2, CROWD_ATTRIB);
+    if (crowdProgram == 0) return;
+
+    timeLocation = glExtGetUniformLocation(crowdProgram, "time");
+    jumpRateLocation = glExtGetUniformLocation(crowdProgram, "jumpRate");
+    jumpHeightLocation = glExtGetUniformLocation(crowdProgram, "jumpHeight");
+}
+
+void uploadCrowd(const std::vector<Person>& people) {
+    std::vector<CrowdInstance> instances;
+    packCrowdInstances(people, instances);
+    crowdCount = (GLsizei)instances.size();
+    crowdCpu.swap(instances);
+
+    if (crowdProgram == 0) return;
+
+    if (crowdVbo == 0) glExtGenBuffers(1, &crowdVbo);
+    glExtBindBuffer(GL_ARRAY_BUFFER, crowdVbo);
+    glExtBufferData(GL_ARRAY_BUFFER, crowdCpu.size() * sizeof(CrowdInstance),
+        crowdCpu.empty() ? nullptr : crowdCpu.data(), GL_STATIC_DRAW);
+    glExtBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void drawCrowd(float time, const std::vector<int>* visible) {
+    if (crowdCount == 0) return;
+    if (visible && visible->empty()) return;
+
+    if (crowdProgram == 0) {
+        size_t count = visible ? visible->size() : crowdCpu.size();
+        for (size_t n = 0; n < count; n++) {
+            const CrowdInstance& inst = crowdCpu[visible ? (size_t)(*visible)[n] : n];
+            glPushMatrix();
+            glTranslatef(inst.x, inst.baseY + crowdJumpOffset(inst, time), inst.z);
+            glColor3f(inst.r, inst.g, inst.b);
+            drawMesh(personMesh);
+            glPopMatrix();
+        }
+        return;
+    }
+
+    glExtUseProgram(crowdProgram);
+    glExtUniform1f(timeLocation, time);
+    glExtUniform1f(jumpRateLocation, CROWD_REFERENCE_FPS);
+    glExtUniform1f(jumpHeightLocation, CROWD_JUMP_HEIGHT);
+
+    GLuint vbo = crowdVbo;
+    GLsizei count = crowdCount;
+    if (visible) {
+        static std::vector<CrowdInstance> subset;
+        subset.resize(visible->size());
+        for (size_t n = 0; n < visible->size(); n++) subset[n] = crowdCpu[(*visible)[n]];
+
+        // Orphan and refill so the driver need not wait on last frame's draw
+        if (visibleVbo == 0) glExtGenBuffers(1, &visibleVbo);
+        glExtBindBuffer(GL_ARRAY_BUFFER, visibleVbo);
+        glExtBufferData(GL_ARRAY_BUFFER, crowdCpu.size() * sizeof(CrowdInstance), nullptr, GL_STREAM_DRAW);
+        glExtBufferSubData(GL_ARRAY_BUFFER, 0, subset.size() * sizeof(CrowdInstance), subset.data());
+        vbo = visibleVbo;
+        count = (GLsizei)subset.size();
+    }
+
+    bindMeshArrays(personMesh);
+    glExtBindBuffer(GL_ARRAY_BUFFER, vbo);
+    GLsizei stride = sizeof(CrowdInstance);
+    for (GLuint i = 0; i < 2; i++) {
+        glExtEnableVertexAttribArray(CROWD_ATTRIB + i);
+        glExtVertexAttribPointer(CROWD_ATTRIB + i, 4, GL_FLOAT, GL_FALSE, stride,
+            (const void*)(i * 4 * sizeof(float)));
+        glExtVertexAttribDivisor(CROWD_ATTRIB + i, 1);
+    }
+    glExtBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glExtDrawArraysInstanced(personMesh.mode, 0, personMesh.count, count);
+
+    for (GLuint i = 0; i < 2; i++) {
+        glExtVertexAttribDivisor(CROWD_ATTRIB + i, 0);
+        glExtDisableVertexAttribArray(CROWD_ATTRIB + i);
+    }
+    unbindMeshArrays(personMesh);
+    glExtUseProgram(0);
+}
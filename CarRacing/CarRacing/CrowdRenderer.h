@@ -0,0 +1,23 @@
+#ifndef CROWDRENDERER_H
+#define CROWDRENDERER_H
+
+#include "World.h"
+#include <vector>
+
+// Spectators live in one static instance buffer; a vertex shader animates
+// the jump from a time uniform, so CPU cost per frame does not depend on
+// crowd size. Without GL 3.3 each person is one drawMesh() with the jump
+// computed on the CPU.
+
+// Call once after loadGLExtensions().
+void initCrowdRenderer();
+
+// Re-uploads the crowd. Call whenever the audience is regenerated.
+void uploadCrowd(const std::vector<Person>& people);
+
+// time in seconds. visible, when given, lists the indices of the people to
+// draw (from the frustum cull); they are repacked into a stream buffer each
+// frame. Otherwise the whole static buffer is drawn.
+void drawCrowd(float time, const std::vector<int>* visible = nullptr);
+
+#endif // CROWDRENDERER_H
@@ -0,0 +1,91 @@
+#include "Frustum.h"
+#include <cmath>
+
+// out = a * b, column-major 4x4
+static void multiply4x4(float out[16], const float a[16], const float b[16]) {
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            out[c * 4 + r] = a[0 * 4 + r] * b[c * 4 + 0] + a[1 * 4 + r] * b[c * 4 + 1] +
+                a[2 * 4 + r] * b[c * 4 + 2] + a[3 * 4 + r] * b[c * 4 + 3];
+        }
+    }
+}
+
+void extractFrustum(Frustum& frustum, const float proj[16], const float modelview[16]) {
+    float m[16];
+    multiply4x4(m, proj, modelview);
+
+    // Row i of the clip matrix is (m[i], m[4 + i], m[8 + i], m[12 + i])
+    for (int p = 0; p < 6; p++) {
+        int row = p / 2;
+        float sign = (p % 2 == 0) ? 1.0f : -1.0f;
+        float* plane = frustum.planes[p];
+        plane[0] = m[3] + sign * m[row];
+        plane[1] = m[7] + sign * m[4 + row];
+        plane[2] = m[11] + sign * m[8 + row];
+        plane[3] = m[15] + sign * m[12 + row];
+
+        float len = sqrtf(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        if (len > 0.0f) {
+            plane[0] /= len; plane[1] /= len; plane[2] /= len; plane[3] /= len;
+        }
+    }
+}
+
+bool aabbInFrustum(const Frustum& frustum,
+    float minX, float minY, float minZ, float maxX, float maxY, float maxZ) {
+    for (int p = 0; p < 6; p++) {
+        const float* plane = frustum.planes[p];
+        // Corner furthest along the plane normal
+        float x = plane[0] >= 0.0f ? maxX : minX;
+        float y = plane[1] >= 0.0f ? maxY : minY;
+        float z = plane[2] >= 0.0f ? maxZ : minZ;
+        if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < 0.0f) return false;
+    }
+    return true;
+}
+
+bool aabbInsideFrustum(const Frustum& frustum,
+    float minX, float minY, float minZ, float maxX, float maxY, float maxZ) {
+    for (int p = 0; p < 6; p++) {
+        const float* plane = frustum.planes[p];
+        // Corner furthest against the plane normal
+        float x = plane[0] >= 0.0f ? minX : maxX;
+        float y = plane[1] >= 0.0f ? minY : maxY;
+        float z = plane[2] >= 0.0f ? minZ : maxZ;
+        if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < 0.0f) return false;
+    }
+    return true;
+}
+
+void makePerspectiveMatrix(float out[16], float fovyDeg, float aspect, float zNear, float zFar) {
+    float f = 1.0f / tanf(fovyDeg * 3.14159265358979323846f / 360.0f);
+    for (int i = 0; i < 16; i++) out[i] = 0.0f;
+    out[0] = f / aspect;
+    out[5] = f;
+    out[10] = (zFar + zNear) / (zNear - zFar);
+    out[11] = -1.0f;
+    out[14] = 2.0f * zFar * zNear / (zNear - zFar);
+}
+
+void makeLookAtMatrix(float out[16], float eyeX, float eyeY, float eyeZ,
+    float centerX, float centerY, float centerZ, float upX, float upY, float upZ) {
+    float fx = centerX - eyeX, fy = centerY - eyeY, fz = centerZ - eyeZ;
+    float fl = sqrtf(fx * fx + fy * fy + fz * fz);
+    fx /= fl; fy /= fl; fz /= fl;
+
+    // s = f x up, u = s x f
+    float sx = fy * upZ - fz * upY, sy = fz * upX - fx * upZ, sz = fx * upY - fy * upX;
+    float sl = sqrtf(sx * sx + sy * sy + sz * sz);
+    sx /= sl; sy /= sl; sz /= sl;
+    float ux = sy * fz - sz * fy, uy = sz * fx - sx * fz, uz = sx * fy - sy * fx;
+
+    out[0] = sx; out[4] = sy; out[8] = sz;
+    out[1] = ux; out[5] = uy; out[9] = uz;
+    out[2] = -fx; out[6] = -fy; out[10] = -fz;
+    out[3] = 0.0f; out[7] = 0.0f; out[11] = 0.0f;
+    out[12] = -(sx * eyeX + sy * eyeY + sz * eyeZ);
+    out[13] = -(ux * eyeX + uy * eyeY + uz * eyeZ);
+    out[14] = fx * eyeX + fy * eyeY + fz * eyeZ;
+    out[15] = 1.0f;
+}
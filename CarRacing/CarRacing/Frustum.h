@@ -0,0 +1,29 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+// GL-free view frustum. Built from the same column-major matrices GL uses,
+// so the renderer can feed it glGetFloatv() results and the benchmark can
+// build its own with the helpers below.
+
+struct Frustum {
+    float planes[6][4]; // ax + by + cz + d >= 0 inside; left, right, bottom, top, near, far
+};
+
+// Planes of proj * modelview (Gribb/Hartmann extraction), normalized.
+void extractFrustum(Frustum& frustum, const float proj[16], const float modelview[16]);
+
+// False only when the box is completely outside one plane. Conservative:
+// boxes near a frustum corner may pass.
+bool aabbInFrustum(const Frustum& frustum,
+    float minX, float minY, float minZ, float maxX, float maxY, float maxZ);
+
+// True when the box is entirely inside all six planes.
+bool aabbInsideFrustum(const Frustum& frustum,
+    float minX, float minY, float minZ, float maxX, float maxY, float maxZ);
+
+// Same matrices gluPerspective()/gluLookAt() produce, column-major.
+void makePerspectiveMatrix(float out[16], float fovyDeg, float aspect, float zNear, float zFar);
+void makeLookAtMatrix(float out[16], float eyeX, float eyeY, float eyeZ,
+    float centerX, float centerY, float centerZ, float upX, float upY, float upZ);
+
+#endif // FRUSTUM_H
@@ -0,0 +1,141 @@
+#include "GLExtensions.h"
+#ifndef _WIN32
+#include <GL/glx.h>
+#endif
+#include <cstdio>
+#include <cstring>
+
+GLGenBuffersFn glExtGenBuffers = nullptr;
+GLDeleteBuffersFn glExtDeleteBuffers = nullptr;
+GLBindBufferFn glExtBindBuffer = nullptr;
+GLBufferDataFn glExtBufferData = nullptr;
+GLBufferSubDataFn glExtBufferSubData = nullptr;
+GLGenVertexArraysFn glExtGenVertexArrays = nullptr;
+GLDeleteVertexArraysFn glExtDeleteVertexArrays = nullptr;
+GLBindVertexArrayFn glExtBindVertexArray = nullptr;
+GLCreateShaderFn glExtCreateShader = nullptr;
+GLShaderSourceFn glExtShaderSource = nullptr;
+GLCompileShaderFn glExtCompileShader = nullptr;
+GLGetShaderivFn glExtGetShaderiv = nullptr;
+GLGetShaderInfoLogFn glExtGetShaderInfoLog = nullptr;
+GLDeleteShaderFn glExtDeleteShader = nullptr;
+GLCreateProgramFn glExtCreateProgram = nullptr;
+GLAttachShaderFn glExtAttachShader = nullptr;
+GLBindAttribLocationFn glExtBindAttribLocation = nullptr;
+GLLinkProgramFn glExtLinkProgram = nullptr;
+GLGetProgramivFn glExtGetProgramiv = nullptr;
+GLGetProgramInfoLogFn glExtGetProgramInfoLog = nullptr;
+GLDeleteProgramFn glExtDeleteProgram = nullptr;
+GLUseProgramFn glExtUseProgram = nullptr;
+GLGetUniformLocationFn glExtGetUniformLocation = nullptr;
+GLUniform1iFn glExtUniform1i = nullptr;
+GLUniform1fFn glExtUniform1f = nullptr;
+GLEnableVertexAttribArrayFn glExtEnableVertexAttribArray = nullptr;
+GLDisableVertexAttribArrayFn glExtDisableVertexAttribArray = nullptr;
+GLVertexAttribPointerFn glExtVertexAttribPointer = nullptr;
+GLVertexAttribDivisorFn glExtVertexAttribDivisor = nullptr;
+GLDrawArraysInstancedFn glExtDrawArraysInstanced = nullptr;
+GLGenQueriesFn glExtGenQueries = nullptr;
+GLDeleteQueriesFn glExtDeleteQueries = nullptr;
+GLQueryCounterFn glExtQueryCounter = nullptr;
+GLGetQueryObjectivFn glExtGetQueryObjectiv = nullptr;
+GLGetQueryObjectui64vFn glExtGetQueryObjectui64v = nullptr;
+GLGetInteger64vFn glExtGetInteger64v = nullptr;
+GLCompressedTexImage2DFn glExtCompressedTexImage2D = nullptr;
+
+bool glHasVBO = false;
+bool glHasVAO = false;
+bool glHasShaders = false;
+bool glHasInstancing = false;
+bool glHasTimerQuery = false;
+bool glHasS3tc = false;
+
+static void* getProc(const char* name) {
+#ifdef _WIN32
+    void* p = (void*)wglGetProcAddress(name);
+    // wglGetProcAddress reports some failures as small integers
+    if (p == (void*)0 || p == (void*)1 || p == (void*)2 || p == (void*)3 || p == (void*)-1) return nullptr;
+    return p;
+#else
+    return (void*)glXGetProcAddressARB((const GLubyte*)name);
+#endif
+}
+
+// Parses "major.minor" from GL_VERSION; glX can hand back pointers for
+// entry points the driver does not implement, so the version gates them.
+static void getGLVersion(int& major, int& minor) {
+    major = 1; minor = 1;
+    const char* version = (const char*)glGetString(GL_VERSION);
+    if (version) sscanf(version, "%d.%d", &major, &minor);
+}
+
+void loadGLExtensions() {
+    int major, minor;
+    getGLVersion(major, minor);
+    int glVersion = major * 10 + minor;
+
+    glExtGenBuffers = (GLGenBuffersFn)getProc("glGenBuffers");
+    glExtDeleteBuffers = (GLDeleteBuffersFn)getProc("glDeleteBuffers");
+    glExtBindBuffer = (GLBindBufferFn)getProc("glBindBuffer");
+    glExtBufferData = (GLBufferDataFn)getProc("glBufferData");
+    glExtBufferSubData = (GLBufferSubDataFn)getProc("glBufferSubData");
+    glHasVBO = glVersion >= 15 && glExtGenBuffers && glExtDeleteBuffers &&
+        glExtBindBuffer && glExtBufferData && glExtBufferSubData;
+
+    glExtGenVertexArrays = (GLGenVertexArraysFn)getProc("glGenVertexArrays");
+    glExtDeleteVertexArrays = (GLDeleteVertexArraysFn)getProc("glDeleteVertexArrays");
+    glExtBindVertexArray = (GLBindVertexArrayFn)getProc("glBindVertexArray");
+    glHasVAO = glHasVBO && glVersion >= 30 && glExtGenVertexArrays &&
+        glExtDeleteVertexArrays && glExtBindVertexArray;
+
+    glExtCreateShader = (GLCreateShaderFn)getProc("glCreateShader");
+    glExtShaderSource = (GLShaderSourceFn)getProc("glShaderSource");
+    glExtCompileShader = (GLCompileShaderFn)getProc("glCompileShader");
+    glExtGetShaderiv = (GLGetShaderivFn)getProc("glGetShaderiv");
+    glExtGetShaderInfoLog = (GLGetShaderInfoLogFn)getProc("glGetShaderInfoLog");
+    glExtDeleteShader = (GLDeleteShaderFn)getProc("glDeleteShader");
+    glExtCreateProgram = (GLCreateProgramFn)getProc("glCreateProgram");
+    glExtAttachShader = (GLAttachShaderFn)getProc("glAttachShader");
+    glExtBindAttribLocation = (GLBindAttribLocationFn)getProc("glBindAttribLocation");
+    glExtLinkProgram = (GLLinkProgramFn)getProc("glLinkProgram");
+    glExtGetProgramiv = (GLGetProgramivFn)getProc("glGetProgramiv");
+    glExtGetProgramInfoLog = (GLGetProgramInfoLogFn)getProc("glGetProgramInfoLog");
+    glExtDeleteProgram = (GLDeleteProgramFn)getProc("glDeleteProgram");
+    glExtUseProgram = (GLUseProgramFn)getProc("glUseProgram");
+    glExtGetUniformLocation = (GLGetUniformLocationFn)getProc("glGetUniformLocation");
+    glExtUniform1i = (GLUniform1iFn)getProc("glUniform1i");
+    glExtUniform1f = (GLUniform1fFn)getProc("glUniform1f");
+    glExtEnableVertexAttribArray = (GLEnableVertexAttribArrayFn)getProc("glEnableVertexAttribArray");
+    glExtDisableVertexAttribArray = (GLDisableVertexAttribArrayFn)getProc("glDisableVertexAttribArray");
+    glExtVertexAttribPointer = (GLVertexAttribPointerFn)getProc("glVertexAttribPointer");
+    glHasShaders = glVersion >= 20 && glExtCreateShader && glExtShaderSource &&
+        glExtCompileShader && glExtGetShaderiv && glExtGetShaderInfoLog && glExtDeleteShader &&
+        glExtCreateProgram && glExtAttachShader && glExtBindAttribLocation && glExtLinkProgram &&
+        glExtGetProgramiv && glExtGetProgramInfoLog && glExtDeleteProgram && glExtUseProgram &&
+        glExtGetUniformLocation && glExtUniform1i && glExtUniform1f &&
+        glExtEnableVertexAttribArray && glExtDisableVertexAttribArray && glExtVertexAttribPointer;
+
+    glExtVertexAttribDivisor = (GLVertexAttribDivisorFn)getProc("glVertexAttribDivisor");
+    glExtDrawArraysInstanced = (GLDrawArraysInstancedFn)getProc("glDrawArraysInstanced");
+    glHasInstancing = glHasVBO && glHasShaders && glVersion >= 33 &&
+        glExtVertexAttribDivisor && glExtDrawArraysInstanced;
+
+    glExtGenQueries = (GLGenQueriesFn)getProc("glGenQueries");
+    glExtDeleteQueries = (GLDeleteQueriesFn)getProc("glDeleteQueries");
+    glExtQueryCounter = (GLQueryCounterFn)getProc("glQueryCounter");
+    glExtGetQueryObjectiv = (GLGetQueryObjectivFn)getProc("glGetQueryObjectiv");
+    glExtGetQueryObjectui64v = (GLGetQueryObjectui64vFn)getProc("glGetQueryObjectui64v");
+    glExtGetInteger64v = (GLGetInteger64vFn)getProc("glGetInteger64v");
+    glHasTimerQuery = glVersion >= 33 && glExtGenQueries && glExtDeleteQueries &&
+        glExtQueryCounter && glExtGetQueryObjectiv && glExtGetQueryObjectui64v && glExtGetInteger64v;
+
+    const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+    glExtCompressedTexImage2D = (GLCompressedTexImage2DFn)getProc("glCompressedTexImage2D");
+    glHasS3tc = glVersion >= 13 && glExtCompressedTexImage2D && extensions &&
+        strstr(extensions, "GL_EXT_texture_compression_s3tc") != nullptr;
+
+    printf("GL %d.%d: VBO %s, VAO %s, shaders %s, instancing %s, timer queries %s, S3TC %s\n", major, minor,
+        glHasVBO ? "yes" : "no", glHasVAO ? "yes" : "no",
+        glHasShaders ? "yes" : "no", glHasInstancing ? "yes" : "no",
+        glHasTimerQuery ? "yes" : "no", glHasS3tc ? "yes" : "no");
+}
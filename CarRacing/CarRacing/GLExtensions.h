@@ -0,0 +1,165 @@
+#ifndef GLEXTENSIONS_H
+#define GLEXTENSIONS_H
+
+// Minimal loader for the post-1.1 GL entry points the renderer uses. The
+// Windows GL headers stop at 1.1, so the types and tokens are declared here
+// and the functions are fetched at runtime after the context exists. Each
+// feature has a flag; callers fall back to display lists when it is false.
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+#include <GL/gl.h>
+#include <cstddef>
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+// ===== Tokens =====
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_ELEMENT_ARRAY_BUFFER
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_DYNAMIC_DRAW
+#define GL_DYNAMIC_DRAW 0x88E8
+#endif
+
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+
+#ifndef GL_QUERY_RESULT
+#define GL_QUERY_RESULT 0x8866
+#endif
+#ifndef GL_QUERY_RESULT_AVAILABLE
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
+#ifndef GL_TIMESTAMP
+#define GL_TIMESTAMP 0x8E28
+#endif
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+typedef char GLcharExt;
+typedef ptrdiff_t GLsizeiptrExt;
+typedef ptrdiff_t GLintptrExt;
+typedef long long GLint64Ext;
+typedef unsigned long long GLuint64Ext;
+
+// ===== Function Types =====
+typedef void (APIENTRY* GLGenBuffersFn)(GLsizei n, GLuint* buffers);
+typedef void (APIENTRY* GLDeleteBuffersFn)(GLsizei n, const GLuint* buffers);
+typedef void (APIENTRY* GLBindBufferFn)(GLenum target, GLuint buffer);
+typedef void (APIENTRY* GLBufferDataFn)(GLenum target, GLsizeiptrExt size, const void* data, GLenum usage);
+typedef void (APIENTRY* GLBufferSubDataFn)(GLenum target, GLintptrExt offset, GLsizeiptrExt size, const void* data);
+typedef void (APIENTRY* GLGenVertexArraysFn)(GLsizei n, GLuint* arrays);
+typedef void (APIENTRY* GLDeleteVertexArraysFn)(GLsizei n, const GLuint* arrays);
+typedef void (APIENTRY* GLBindVertexArrayFn)(GLuint array);
+typedef GLuint (APIENTRY* GLCreateShaderFn)(GLenum type);
+typedef void (APIENTRY* GLShaderSourceFn)(GLuint shader, GLsizei count, const GLcharExt* const* string, const GLint* length);
+typedef void (APIENTRY* GLCompileShaderFn)(GLuint shader);
+typedef void (APIENTRY* GLGetShaderivFn)(GLuint shader, GLenum pname, GLint* params);
+typedef void (APIENTRY* GLGetShaderInfoLogFn)(GLuint shader, GLsizei bufSize, GLsizei* length, GLcharExt* infoLog);
+typedef void (APIENTRY* GLDeleteShaderFn)(GLuint shader);
+typedef GLuint (APIENTRY* GLCreateProgramFn)(void);
+typedef void (APIENTRY* GLAttachShaderFn)(GLuint program, GLuint shader);
+typedef void (APIENTRY* GLBindAttribLocationFn)(GLuint program, GLuint index, const GLcharExt* name);
+typedef void (APIENTRY* GLLinkProgramFn)(GLuint program);
+typedef void (APIENTRY* GLGetProgramivFn)(GLuint program, GLenum pname, GLint* params);
+typedef void (APIENTRY* GLGetProgramInfoLogFn)(GLuint program, GLsizei bufSize, GLsizei* length, GLcharExt* infoLog);
+typedef void (APIENTRY* GLDeleteProgramFn)(GLuint program);
+typedef void (APIENTRY* GLUseProgramFn)(GLuint program);
+typedef GLint (APIENTRY* GLGetUniformLocationFn)(GLuint program, const GLcharExt* name);
+typedef void (APIENTRY* GLUniform1iFn)(GLint location, GLint v0);
+typedef void (APIENTRY* GLUniform1fFn)(GLint location, GLfloat v0);
+typedef void (APIENTRY* GLEnableVertexAttribArrayFn)(GLuint index);
+typedef void (APIENTRY* GLDisableVertexAttribArrayFn)(GLuint index);
+typedef void (APIENTRY* GLVertexAttribPointerFn)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+typedef void (APIENTRY* GLVertexAttribDivisorFn)(GLuint index, GLuint divisor);
+typedef void (APIENTRY* GLDrawArraysInstancedFn)(GLenum mode, GLint first, GLsizei count, GLsizei instancecount);
+typedef void (APIENTRY* GLGenQueriesFn)(GLsizei n, GLuint* ids);
+typedef void (APIENTRY* GLDeleteQueriesFn)(GLsizei n, const GLuint* ids);
+typedef void (APIENTRY* GLQueryCounterFn)(GLuint id, GLenum target);
+typedef void (APIENTRY* GLGetQueryObjectivFn)(GLuint id, GLenum pname, GLint* params);
+typedef void (APIENTRY* GLGetQueryObjectui64vFn)(GLuint id, GLenum pname, GLuint64Ext* params);
+typedef void (APIENTRY* GLGetInteger64vFn)(GLenum pname, GLint64Ext* data);
+typedef void (APIENTRY* GLCompressedTexImage2DFn)(GLenum target, GLint level, GLenum internalformat,
+    GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data);
+
+// ===== Loaded Entry Points =====
+extern GLGenBuffersFn glExtGenBuffers;
+extern GLDeleteBuffersFn glExtDeleteBuffers;
+extern GLBindBufferFn glExtBindBuffer;
+extern GLBufferDataFn glExtBufferData;
+extern GLBufferSubDataFn glExtBufferSubData;
+extern GLGenVertexArraysFn glExtGenVertexArrays;
+extern GLDeleteVertexArraysFn glExtDeleteVertexArrays;
+extern GLBindVertexArrayFn glExtBindVertexArray;
+extern GLCreateShaderFn glExtCreateShader;
+extern GLShaderSourceFn glExtShaderSource;
+extern GLCompileShaderFn glExtCompileShader;
+extern GLGetShaderivFn glExtGetShaderiv;
+extern GLGetShaderInfoLogFn glExtGetShaderInfoLog;
+extern GLDeleteShaderFn glExtDeleteShader;
+extern GLCreateProgramFn glExtCreateProgram;
+extern GLAttachShaderFn glExtAttachShader;
+extern GLBindAttribLocationFn glExtBindAttribLocation;
+extern GLLinkProgramFn glExtLinkProgram;
+extern GLGetProgramivFn glExtGetProgramiv;
+extern GLGetProgramInfoLogFn glExtGetProgramInfoLog;
+extern GLDeleteProgramFn glExtDeleteProgram;
+extern GLUseProgramFn glExtUseProgram;
+extern GLGetUniformLocationFn glExtGetUniformLocation;
+extern GLUniform1iFn glExtUniform1i;
+extern GLUniform1fFn glExtUniform1f;
+extern GLEnableVertexAttribArrayFn glExtEnableVertexAttribArray;
+extern GLDisableVertexAttribArrayFn glExtDisableVertexAttribArray;
+extern GLVertexAttribPointerFn glExtVertexAttribPointer;
+extern GLVertexAttribDivisorFn glExtVertexAttribDivisor;
+extern GLDrawArraysInstancedFn glExtDrawArraysInstanced;
+extern GLGenQueriesFn glExtGenQueries;
+extern GLDeleteQueriesFn glExtDeleteQueries;
+extern GLQueryCounterFn glExtQueryCounter;
+extern GLGetQueryObjectivFn glExtGetQueryObjectiv;
+extern GLGetQueryObjectui64vFn glExtGetQueryObjectui64v;
+extern GLGetInteger64vFn glExtGetInteger64v;
+extern GLCompressedTexImage2DFn glExtCompressedTexImage2D;
+
+// ===== Feature Flags =====
+extern bool glHasVBO;   // GL 1.5 buffer objects
+extern bool glHasVAO;   // GL 3.0 vertex array objects
+extern bool glHasShaders;     // GL 2.0 GLSL programs
+extern bool glHasInstancing;  // GL 3.3 instanced arrays (attribute divisor)
+extern bool glHasTimerQuery;  // GL 3.3 timestamp queries
+extern bool glHasS3tc;        // GL 1.3 compressed textures + EXT_texture_compression_s3tc
+
+// Call once after glutCreateWindow(). Safe to call again.
+void loadGLExtensions();
+
+#endif // GLEXTENSIONS_H
@@ -0,0 +1,109 @@
+#include "GpuMesh.h"
+
+static GLenum toGLMode(MeshPrimitive primitive) {
+    switch (primitive) {
+    case MESH_TRIANGLE_STRIP: return GL_TRIANGLE_STRIP;
+    case MESH_LINES: return GL_LINES;
+    default: return GL_TRIANGLES;
+    }
+}
+
+void setMeshVertexPointers(const MeshVertex* base) {
+    const char* p = (const char*)base;
+    GLsizei stride = sizeof(MeshVertex);
+    glVertexPointer(3, GL_FLOAT, stride, p + offsetof(MeshVertex, x));
+    glNormalPointer(GL_FLOAT, stride, p + offsetof(MeshVertex, nx));
+    glTexCoordPointer(2, GL_FLOAT, stride, p + offsetof(MeshVertex, u));
+    glColorPointer(4, GL_FLOAT, stride, p + offsetof(MeshVertex, r));
+}
+
+void enableMeshArrays(bool vertexColors) {
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    if (vertexColors) glEnableClientState(GL_COLOR_ARRAY);
+}
+
+void disableMeshArrays() {
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+}
+
+void uploadMesh(GpuMesh& gpu, const Mesh& mesh) {
+    releaseMesh(gpu);
+    gpu.mode = toGLMode(mesh.primitive);
+    gpu.count = (GLsizei)mesh.vertices.size();
+    gpu.vertexColors = mesh.useVertexColor;
+    if (gpu.count == 0) return;
+
+    if (!glHasVBO) {
+        // Display-list fallback: arrays are read from client memory at compile time
+        gpu.displayList = glGenLists(1);
+        glNewList(gpu.displayList, GL_COMPILE);
+        enableMeshArrays(gpu.vertexColors);
+        setMeshVertexPointers(mesh.vertices.data());
+        glDrawArrays(gpu.mode, 0, gpu.count);
+        disableMeshArrays();
+        glEndList();
+        return;
+    }
+
+    glExtGenBuffers(1, &gpu.vbo);
+    glExtBindBuffer(GL_ARRAY_BUFFER, gpu.vbo);
+    glExtBufferData(GL_ARRAY_BUFFER, mesh.vertices.size() * sizeof(MeshVertex),
+        mesh.vertices.data(), GL_STATIC_DRAW);
+
+    if (glHasVAO) {
+        // The VAO records the array bindings so drawMesh() is one bind + draw
+        glExtGenVertexArrays(1, &gpu.vao);
+        glExtBindVertexArray(gpu.vao);
+        enableMeshArrays(gpu.vertexColors);
+        setMeshVertexPointers(nullptr);
+        glExtBindVertexArray(0);
+    }
+    glExtBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void drawMesh(const GpuMesh& gpu) {
+    if (gpu.count == 0) return;
+
+    if (gpu.displayList != 0) {
+        glCallList(gpu.displayList);
+        return;
+    }
+
+    bindMeshArrays(gpu);
+    glDrawArrays(gpu.mode, 0, gpu.count);
+    unbindMeshArrays(gpu);
+}
+
+void bindMeshArrays(const GpuMesh& gpu) {
+    if (gpu.vao != 0) {
+        glExtBindVertexArray(gpu.vao);
+        return;
+    }
+    glExtBindBuffer(GL_ARRAY_BUFFER, gpu.vbo);
+    enableMeshArrays(gpu.vertexColors);
+    setMeshVertexPointers(nullptr);
+    glExtBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void unbindMeshArrays(const GpuMesh& gpu) {
+    if (gpu.vao != 0) {
+        glExtBindVertexArray(0);
+        return;
+    }
+    disableMeshArrays();
+}
+
+void releaseMesh(GpuMesh& gpu) {
+    if (gpu.displayList != 0) glDeleteLists(gpu.displayList, 1);
+    if (gpu.vao != 0) glExtDeleteVertexArrays(1, &gpu.vao);
+    if (gpu.vbo != 0) glExtDeleteBuffers(1, &gpu.vbo);
+    gpu.displayList = 0;
+    gpu.vao = 0;
+    gpu.vbo = 0;
+    gpu.count = 0;
+}
@@ -0,0 +1,38 @@
+#ifndef GPUMESH_H
+#define GPUMESH_H
+
+#include "GLExtensions.h"
+#include "Mesh.h"
+
+// A Mesh uploaded once and drawn with a single call. Uses a VBO (plus a VAO
+// when available) and falls back to a display list on GL 1.1 drivers.
+struct GpuMesh {
+    GLuint vbo = 0;
+    GLuint vao = 0;
+    GLuint displayList = 0;
+    GLenum mode = GL_TRIANGLES;
+    GLsizei count = 0;
+    bool vertexColors = true; // false: glColor (or the instance color) applies
+};
+
+// Replaces any previous contents of gpu. Requires loadGLExtensions().
+void uploadMesh(GpuMesh& gpu, const Mesh& mesh);
+
+// Draws with the current texture/lighting state. Colors come from the
+// vertices unless the mesh was built with useVertexColor = false.
+void drawMesh(const GpuMesh& gpu);
+
+// Binds the mesh's arrays without drawing, for callers that issue their own
+// draw (instancing). Not valid for display-list meshes.
+void bindMeshArrays(const GpuMesh& gpu);
+void unbindMeshArrays(const GpuMesh& gpu);
+
+void releaseMesh(GpuMesh& gpu);
+
+// Points the fixed-function arrays at interleaved MeshVertex data, either a
+// bound VBO (base == nullptr) or client memory.
+void setMeshVertexPointers(const MeshVertex* base);
+void enableMeshArrays(bool vertexColors);
+void disableMeshArrays();
+
+#endif // GPUMESH_H
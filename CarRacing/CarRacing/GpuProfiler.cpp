@@ -0,0 +1,85 @@
+#include "GpuProfiler.h"
+
+struct GpuScope {
+    const char* name;
+    int depth;
+    GLuint queries[2]; // begin, end timestamps
+};
+
+struct GpuFrame {
+    GpuScope scopes[GPU_PROFILE_MAX_SCOPES];
+    int count = 0;
+    int frame = 0;
+    long long cpuMinusGpuNs = 0; // added to GPU timestamps to land on the CPU clock
+};
+
+static bool gpuProfilerReady = false;
+static GpuFrame frames[GPU_PROFILE_FRAMES];
+static int currentFrame = 0;
+static int gpuDepth = 0;
+
+void initGpuProfiler() {
+    if (!glHasTimerQuery || gpuProfilerReady) return;
+    for (int f = 0; f < GPU_PROFILE_FRAMES; f++) {
+        for (int s = 0; s < GPU_PROFILE_MAX_SCOPES; s++) {
+            glExtGenQueries(2, frames[f].scopes[s].queries);
+        }
+    }
+    gpuProfilerReady = true;
+}
+
+int gpuProfileBegin(const char* name) {
+    if (!gpuProfilerReady || !profilerEnabled) return -1;
+    GpuFrame& frame = frames[currentFrame];
+    if (frame.count == GPU_PROFILE_MAX_SCOPES) return -1;
+
+    int slot = frame.count++;
+    GpuScope& scope = frame.scopes[slot];
+    scope.name = name;
+    scope.depth = gpuDepth++;
+    glExtQueryCounter(scope.queries[0], GL_TIMESTAMP);
+    return slot;
+}
+
+void gpuProfileEnd(int slot) {
+    if (slot < 0) return;
+    gpuDepth--;
+    glExtQueryCounter(frames[currentFrame].scopes[slot].queries[1], GL_TIMESTAMP);
+}
+
+// Reads a frame recorded GPU_PROFILE_FRAMES ago. A scope whose result is
+// still not available is dropped rather than waited for.
+static void collectFrame(GpuFrame& frame) {
+    for (int s = 0; s < frame.count; s++) {
+        GpuScope& scope = frame.scopes[s];
+        GLint available = 0;
+        glExtGetQueryObjectiv(scope.queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+
+        GLuint64Ext begin = 0, end = 0;
+        glExtGetQueryObjectui64v(scope.queries[0], GL_QUERY_RESULT, &begin);
+        glExtGetQueryObjectui64v(scope.queries[1], GL_QUERY_RESULT, &end);
+        if (end < begin) continue;
+
+        profileRecord(scope.name, (long long)begin + frame.cpuMinusGpuNs,
+            (long long)(end - begin), PROFILE_TRACK_GPU, scope.depth, frame.frame);
+    }
+    frame.count = 0;
+}
+
+void gpuProfileNextFrame() {
+    if (!gpuProfilerReady) return;
+
+    currentFrame = (currentFrame + 1) % GPU_PROFILE_FRAMES;
+    GpuFrame& frame = frames[currentFrame];
+    collectFrame(frame);
+    gpuDepth = 0;
+    if (!profilerEnabled) return;
+
+    // GL_TIMESTAMP is the GPU clock once earlier commands reach the server;
+    // close enough to line the two tracks up in the trace.
+    GLint64Ext gpuNow = 0;
+    glExtGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    frame.cpuMinusGpuNs = profileNowNs() - gpuNow;
+    frame.frame = profileFrame();
+}
@@ -0,0 +1,38 @@
+#ifndef GPUPROFILER_H
+#define GPUPROFILER_H
+
+#include "GLExtensions.h"
+#include "Profiler.h"
+
+// GPU side of the frame profiler. Each pass brackets its commands with two
+// timestamp queries; results are read a few frames later, once the GPU
+// has caught up, so timing never stalls the pipeline. They are recorded
+// on PROFILE_TRACK_GPU, shifted onto the CPU clock. Without GL 3.3 timer
+// queries only the CPU timings are recorded.
+
+const int GPU_PROFILE_FRAMES = 4;     // frames in flight before results are read
+const int GPU_PROFILE_MAX_SCOPES = 64; // per frame; further scopes are CPU only
+
+// Call once after loadGLExtensions().
+void initGpuProfiler();
+
+// Returns a query slot, or -1 when profiling is off or unavailable.
+int gpuProfileBegin(const char* name);
+void gpuProfileEnd(int slot);
+
+// Call once per frame before the first pass: reads back the oldest frame's
+// results and starts a new frame.
+void gpuProfileNextFrame();
+
+struct GpuProfileScope {
+    ProfileScope cpu;
+    int slot;
+
+    explicit GpuProfileScope(const char* name) : cpu(name), slot(gpuProfileBegin(name)) {}
+    ~GpuProfileScope() { gpuProfileEnd(slot); }
+};
+
+// Times the rest of the enclosing block on both the CPU and GPU tracks.
+#define PROFILE_PASS(name) GpuProfileScope PROFILE_CONCAT(profilePass, __LINE__)(name)
+
+#endif // GPUPROFILER_H
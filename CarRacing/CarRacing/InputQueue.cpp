@@ -0,0 +1,57 @@
+#include "InputQueue.h"
+
+bool pushInputEvent(InputQueue& queue, const InputEvent& event) {
+    unsigned head = queue.head.load(std::memory_order_relaxed);
+    // acquire: the consumer is done reading the slot about to be reused
+    if (head - queue.tail.load(std::memory_order_acquire) >= (unsigned)INPUT_QUEUE_CAPACITY) {
+        if (!event.pressed) queue.lostReleases.fetch_or(event.key, std::memory_order_relaxed);
+        return false;
+    }
+    // A press overrides a release lost before it
+    if (event.pressed) queue.lostReleases.fetch_and(~event.key, std::memory_order_relaxed);
+    queue.events[head & (INPUT_QUEUE_CAPACITY - 1)] = event;
+    queue.head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool popInputEvent(InputQueue& queue, long long untilNs, InputEvent& event) {
+    unsigned tail = queue.tail.load(std::memory_order_relaxed);
+    // acquire: the event written before head moved is visible
+    if (tail == queue.head.load(std::memory_order_acquire)) return false;
+    const InputEvent& next = queue.events[tail & (INPUT_QUEUE_CAPACITY - 1)];
+    if (next.timeNs > untilNs) return false;
+    event = next;
+    queue.tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+unsigned consumeInputEvents(InputQueue& queue, InputState& state, long long untilNs) {
+    // Taps from the last step come up now
+    state.held &= ~state.releaseNext;
+    state.releaseNext = 0;
+
+    unsigned pressedNow = 0;
+    InputEvent event;
+    while (popInputEvent(queue, untilNs, event)) {
+        if (event.pressed) {
+            state.held |= event.key;
+            pressedNow |= event.key;
+            state.releaseNext &= ~event.key;
+        } else if (pressedNow & event.key) {
+            state.releaseNext |= event.key;
+        } else {
+            state.held &= ~event.key;
+        }
+        state.lastEventNs = event.timeNs;
+    }
+
+    // Releases that didn't fit happened after everything in the queue, so
+    // they apply once it is empty
+    unsigned tail = queue.tail.load(std::memory_order_relaxed);
+    if (tail == queue.head.load(std::memory_order_acquire) && queue.lostReleases.load(std::memory_order_relaxed)) {
+        unsigned lost = queue.lostReleases.exchange(0, std::memory_order_relaxed);
+        state.releaseNext |= lost & pressedNow;
+        state.held &= ~(lost & ~pressedNow);
+    }
+    return state.held;
+}
@@ -0,0 +1,51 @@
+#ifndef INPUTQUEUE_H
+#define INPUTQUEUE_H
+
+#include <atomic>
+
+// Key presses and releases passed from the window thread to the simulation
+// as timestamped events in a single-producer single-consumer ring: no locks,
+// no event lost between frames, and each one applied at the physics step it
+// happened in. GL-free.
+
+const int INPUT_QUEUE_CAPACITY = 256;   // power of two
+
+struct InputEvent {
+    long long timeNs;  // profileNowNs() when it happened
+    unsigned key;      // one caller-defined key bit
+    bool pressed;      // false: released
+};
+
+// Exactly one producer and one consumer thread. head and tail count events
+// ever pushed and popped; each side writes only its own.
+struct InputQueue {
+    InputEvent events[INPUT_QUEUE_CAPACITY];
+    std::atomic<unsigned> head{ 0 };  // producer
+    std::atomic<unsigned> tail{ 0 };  // consumer
+    std::atomic<unsigned> lostReleases{ 0 }; // keys whose release didn't fit
+};
+
+// Producer only. Returns false (and drops the event) if the consumer is
+// INPUT_QUEUE_CAPACITY events behind. A dropped release is still kept as a
+// key bit, so the key can't stay down for good: consumeInputEvents() lets
+// it up once it has caught up with the queue, unless the key was pressed
+// again since.
+bool pushInputEvent(InputQueue& queue, const InputEvent& event);
+
+// Consumer only. Takes the oldest event if it happened at or before
+// untilNs.
+bool popInputEvent(InputQueue& queue, long long untilNs, InputEvent& event);
+
+// Keys as the simulation sees them, consumer side.
+struct InputState {
+    unsigned held = 0;          // key bits down
+    unsigned releaseNext = 0;   // pressed and released within one step
+    long long lastEventNs = 0;  // newest event applied
+};
+
+// Applies every event up to untilNs (the start of a step) to state and
+// returns the keys down for that step. A key pressed and released between
+// two steps is down for one step rather than never seen.
+unsigned consumeInputEvents(InputQueue& queue, InputState& state, long long untilNs);
+
+#endif // INPUTQUEUE_H
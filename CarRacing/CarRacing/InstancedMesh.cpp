@@ -0,0 +1,141 @@
+#include "InstancedMesh.h"
+#include "Shader.h"
+
+// Generic attribute slots for the instance data. Kept clear of the slots
+// some drivers alias to gl_Vertex/gl_Normal/gl_Color/gl_MultiTexCoord0.
+static const GLuint INSTANCE_ATTRIB = 10;
+
+static GLuint instanceProgram = 0;
+static GLint litLocation = -1;
+static GLint useTextureLocation = -1;
+static GLint texLocation = -1;
+
+static const char* instanceVertexSource =
+    "#version 120\n"
+    "attribute vec4 instPosYaw;\n"
+    "attribute vec4 instScale;\n"
+    "attribute vec4 instColor;\n"
+    "uniform int lit;\n"
+    "varying vec4 color;\n"
+    GLSL_FIXED_LIGHTING
+    "void main() {\n"
+    "    float yaw = radians(instPosYaw.w);\n"
+    "    float c = cos(yaw), s = sin(yaw);\n"
+    "    vec3 p = gl_Vertex.xyz * instScale.xyz;\n"
+    "    vec3 world = vec3(c * p.x + s * p.z, p.y, -s * p.x + c * p.z) + instPosYaw.xyz;\n"
+    "    vec3 n = gl_Normal / instScale.xyz;\n"
+    "    n = vec3(c * n.x + s * n.z, n.y, -s * n.x + c * n.z);\n"
+    "    gl_Position = gl_ModelViewProjectionMatrix * vec4(world, 1.0);\n"
+    "    gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+    "    vec4 base = gl_Color * instColor;\n"
+    "    if (lit != 0) {\n"
+    "        vec3 N = normalize(gl_NormalMatrix * n);\n"
+    "        vec3 eyePos = (gl_ModelViewMatrix * vec4(world, 1.0)).xyz;\n"
+    "        color = vec4(base.rgb * fixedLighting(N, eyePos), base.a);\n"
+    "    }\n"
+    "    else {\n"
+    "        color = base;\n"
+    "    }\n"
+    "}\n";
+
+static const char* instanceFragmentSource =
+    "#version 120\n"
+    "uniform sampler2D tex;\n"
+    "uniform int useTexture;\n"
+    "varying vec4 color;\n"
+    "void main() {\n"
+    "    vec4 c = color;\n"
+    "    if (useTexture != 0) c *= texture2D(tex, gl_TexCoord[0].st);\n"
+    "    gl_FragColor = c;\n"
+    "}\n";
+
+void initInstancedRenderer() {
+    if (!glHasInstancing || instanceProgram != 0) return;
+
+    const char* attribs[] = { "instPosYaw", "instScale", "instColor" };
+    instanceProgram = createShaderProgram(instanceVertexSource, instanceFragmentSource,
+        attribs, 3, INSTANCE_ATTRIB);
+    if (instanceProgram == 0) return;
+
+    litLocation = glExtGetUniformLocation(instanceProgram, "lit");
+    useTextureLocation = glExtGetUniformLocation(instanceProgram, "useTexture");
+    texLocation = glExtGetUniformLocation(instanceProgram, "tex");
+}
+
+void uploadInstances(InstanceBuffer& buffer, const std::vector<MeshInstance>& instances,
+    bool dynamic) {
+    buffer.count = (GLsizei)instances.size();
+    if (instanceProgram == 0) {
+        buffer.instances = instances;
+        return;
+    }
+
+    GLsizeiptrExt bytes = instances.size() * sizeof(MeshInstance);
+    if (buffer.vbo == 0) glExtGenBuffers(1, &buffer.vbo);
+    glExtBindBuffer(GL_ARRAY_BUFFER, buffer.vbo);
+    glExtBufferData(GL_ARRAY_BUFFER, bytes, instances.empty() ? nullptr : instances.data(),
+        dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    glExtBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// One drawMesh() per instance under the matrix stack.
+static void drawInstancesFixedFunction(const GpuMesh& mesh, const InstanceBuffer& buffer) {
+    for (const MeshInstance& inst : buffer.instances) {
+        glPushMatrix();
+        glTranslatef(inst.x, inst.y, inst.z);
+        glRotatef(inst.yaw, 0.0f, 1.0f, 0.0f);
+        glScalef(inst.sx, inst.sy, inst.sz);
+        glColor4f(inst.r, inst.g, inst.b, inst.a);
+        drawMesh(mesh);
+        glPopMatrix();
+    }
+}
+
+void drawMeshInstanced(const GpuMesh& mesh, const InstanceBuffer& buffer, GLuint texture) {
+    if (buffer.count == 0 || mesh.count == 0) return;
+
+    if (texture != 0) {
+        glEnable(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, texture);
+    }
+
+    if (instanceProgram == 0 || buffer.vbo == 0 || mesh.vbo == 0) {
+        drawInstancesFixedFunction(mesh, buffer);
+    }
+    else {
+        glExtUseProgram(instanceProgram);
+        glExtUniform1i(litLocation, glIsEnabled(GL_LIGHTING) ? 1 : 0);
+        glExtUniform1i(useTextureLocation, texture != 0 ? 1 : 0);
+        glExtUniform1i(texLocation, 0);
+        if (!mesh.vertexColors) glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+        bindMeshArrays(mesh);
+        glExtBindBuffer(GL_ARRAY_BUFFER, buffer.vbo);
+        GLsizei stride = sizeof(MeshInstance);
+        for (GLuint i = 0; i < 3; i++) {
+            glExtEnableVertexAttribArray(INSTANCE_ATTRIB + i);
+            glExtVertexAttribPointer(INSTANCE_ATTRIB + i, 4, GL_FLOAT, GL_FALSE, stride,
+                (const void*)(i * 4 * sizeof(float)));
+            glExtVertexAttribDivisor(INSTANCE_ATTRIB + i, 1);
+        }
+        glExtBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        glExtDrawArraysInstanced(mesh.mode, 0, mesh.count, buffer.count);
+
+        for (GLuint i = 0; i < 3; i++) {
+            glExtVertexAttribDivisor(INSTANCE_ATTRIB + i, 0);
+            glExtDisableVertexAttribArray(INSTANCE_ATTRIB + i);
+        }
+        unbindMeshArrays(mesh);
+        glExtUseProgram(0);
+    }
+
+    if (texture != 0) glDisable(GL_TEXTURE_2D);
+}
+
+void releaseInstances(InstanceBuffer& buffer) {
+    if (buffer.vbo != 0) glExtDeleteBuffers(1, &buffer.vbo);
+    buffer.vbo = 0;
+    buffer.count = 0;
+    buffer.instances.clear();
+}
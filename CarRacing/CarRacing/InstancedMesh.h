@@ -0,0 +1,30 @@
+#ifndef INSTANCEDMESH_H
+#define INSTANCEDMESH_H
+
+#include "GpuMesh.h"
+#include <vector>
+
+// Draws one GpuMesh many times from a buffer of MeshInstance records.
+// With GL 3.3 this is a single glDrawArraysInstanced; otherwise it falls
+// back to one drawMesh() per instance under the matrix stack.
+struct InstanceBuffer {
+    GLuint vbo = 0;
+    GLsizei count = 0;
+    std::vector<MeshInstance> instances; // CPU copy, only kept for the fallback path
+};
+
+// Compiles the instancing shader. Call once after loadGLExtensions().
+void initInstancedRenderer();
+
+// dynamic = true for buffers refilled every frame.
+void uploadInstances(InstanceBuffer& buffer, const std::vector<MeshInstance>& instances,
+    bool dynamic = false);
+
+// Lit when GL_LIGHTING is enabled. texture = 0 draws untextured. The
+// instance color multiplies the vertex color (or white when the mesh has no
+// vertex colors).
+void drawMeshInstanced(const GpuMesh& mesh, const InstanceBuffer& buffer, GLuint texture = 0);
+
+void releaseInstances(InstanceBuffer& buffer);
+
+#endif // INSTANCEDMESH_H
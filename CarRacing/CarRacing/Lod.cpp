@@ -0,0 +1,15 @@
+#include "Lod.h"
+
+int selectLod(const LodDistances& lod, float distance, int current) {
+    int last = lod.levels - 1;
+    if (current < 0 || current > last) {
+        // No history: plain thresholds
+        int level = 0;
+        while (level < last && distance > lod.distance[level]) level++;
+        return level;
+    }
+
+    while (current < last && distance > lod.distance[current] * (1.0f + lod.hysteresis)) current++;
+    while (current > 0 && distance < lod.distance[current - 1] * (1.0f - lod.hysteresis)) current--;
+    return current;
+}
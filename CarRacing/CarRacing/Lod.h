@@ -0,0 +1,23 @@
+#ifndef LOD_H
+#define LOD_H
+
+// Distance-based level-of-detail selection shared by every primitive that
+// has precomputed mesh levels. Level 0 is the full tessellation.
+
+const int MAX_LOD_LEVELS = 4;
+
+struct LodDistances {
+    int levels;
+    float distance[MAX_LOD_LEVELS - 1]; // camera distance where level i + 1 takes over
+    float hysteresis;                   // fraction of the distance an object must
+                                        // move past a threshold before switching back
+};
+
+// Level for an object at the given camera distance. current is the level
+// the object was drawn at last frame (-1 if none): it only moves to a
+// coarser level once past distance * (1 + hysteresis) and back to a finer
+// one once inside distance * (1 - hysteresis), so objects sitting on a
+// threshold do not flicker between levels.
+int selectLod(const LodDistances& lod, float distance, int current);
+
+#endif // LOD_H
@@ -0,0 +1,91 @@
+#include "Mesh.h"
+#include <cmath>
+
+// ==================== MESH TRANSFORM ====================
+MeshTransform::MeshTransform() {
+    for (int r = 0; r < 3; r++)
+        for (int c = 0; c < 4; c++)
+            m[r][c] = (r == c) ? 1.0f : 0.0f;
+}
+
+// this = this * b, where b is a 3x4 affine matrix
+static void multiplyRight(float m[3][4], const float b[3][4]) {
+    float out[3][4];
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 4; c++) {
+            float v = m[r][0] * b[0][c] + m[r][1] * b[1][c] + m[r][2] * b[2][c];
+            if (c == 3) v += m[r][3];
+            out[r][c] = v;
+        }
+    }
+    for (int r = 0; r < 3; r++)
+        for (int c = 0; c < 4; c++)
+            m[r][c] = out[r][c];
+}
+
+MeshTransform& MeshTransform::translate(float x, float y, float z) {
+    float b[3][4] = { { 1, 0, 0, x }, { 0, 1, 0, y }, { 0, 0, 1, z } };
+    multiplyRight(m, b);
+    return *this;
+}
+
+// Same axis-angle matrix glRotatef() builds
+MeshTransform& MeshTransform::rotate(float angleDeg, float ax, float ay, float az) {
+    float len = sqrtf(ax * ax + ay * ay + az * az);
+    if (len == 0.0f) return *this;
+    ax /= len; ay /= len; az /= len;
+
+    float rad = angleDeg * 3.14159265358979323846f / 180.0f;
+    float c = cosf(rad), s = sinf(rad), t = 1.0f - c;
+    float b[3][4] = {
+        { t * ax * ax + c,      t * ax * ay - s * az, t * ax * az + s * ay, 0 },
+        { t * ax * ay + s * az, t * ay * ay + c,      t * ay * az - s * ax, 0 },
+        { t * ax * az - s * ay, t * ay * az + s * ax, t * az * az + c,      0 },
+    };
+    multiplyRight(m, b);
+    return *this;
+}
+
+MeshTransform& MeshTransform::scale(float x, float y, float z) {
+    float b[3][4] = { { x, 0, 0, 0 }, { 0, y, 0, 0 }, { 0, 0, z, 0 } };
+    multiplyRight(m, b);
+    return *this;
+}
+
+void MeshTransform::transformPoint(float& x, float& y, float& z) const {
+    float px = m[0][0] * x + m[0][1] * y + m[0][2] * z + m[0][3];
+    float py = m[1][0] * x + m[1][1] * y + m[1][2] * z + m[1][3];
+    float pz = m[2][0] * x + m[2][1] * y + m[2][2] * z + m[2][3];
+    x = px; y = py; z = pz;
+}
+
+// Normals go through the cofactor matrix (inverse-transpose up to scale) so
+// non-uniform scales keep them perpendicular, then get renormalized.
+void MeshTransform::transformNormal(float& nx, float& ny, float& nz) const {
+    float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    float c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    float c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    float c10 = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+    float c11 = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+    float c12 = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+    float c20 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+    float c21 = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+    float c22 = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+
+    float x = c00 * nx + c01 * ny + c02 * nz;
+    float y = c10 * nx + c11 * ny + c12 * nz;
+    float z = c20 * nx + c21 * ny + c22 * nz;
+    float len = sqrtf(x * x + y * y + z * z);
+    if (len > 0.0f) { x /= len; y /= len; z /= len; }
+    nx = x; ny = y; nz = z;
+}
+
+// ==================== APPEND ====================
+void appendMesh(Mesh& dst, const Mesh& src, const MeshTransform& xf) {
+    dst.vertices.reserve(dst.vertices.size() + src.vertices.size());
+    for (MeshVertex v : src.vertices) {
+        xf.transformPoint(v.x, v.y, v.z);
+        xf.transformNormal(v.nx, v.ny, v.nz);
+        dst.vertices.push_back(v);
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef MESH_H
+#define MESH_H
+
+#include <vector>
+
+// GL-free geometry container. Meshes are built once on the CPU (and can be
+// built by the headless benchmark), then handed to uploadMesh() in GpuMesh.h.
+
+// Interleaved vertex: position, normal, texcoord, color.
+struct MeshVertex {
+    float x, y, z;
+    float nx, ny, nz;
+    float u, v;
+    float r, g, b, a;
+};
+
+enum MeshPrimitive {
+    MESH_TRIANGLES,
+    MESH_TRIANGLE_STRIP,
+    MESH_LINES
+};
+
+struct Mesh {
+    MeshPrimitive primitive = MESH_TRIANGLES;
+    std::vector<MeshVertex> vertices;
+    bool useVertexColor = true; // false: color comes from glColor / the instance
+};
+
+// Affine transform composed like the GL matrix stack: each call multiplies
+// on the right, so translate().rotate() reads the same as glTranslatef()
+// followed by glRotatef().
+struct MeshTransform {
+    float m[3][4];
+
+    MeshTransform();
+    MeshTransform& translate(float x, float y, float z);
+    MeshTransform& rotate(float angleDeg, float ax, float ay, float az);
+    MeshTransform& scale(float x, float y, float z);
+
+    void transformPoint(float& x, float& y, float& z) const;
+    void transformNormal(float& nx, float& ny, float& nz) const;
+};
+
+// Per-instance data for instanced draws, laid out as three vec4 attributes:
+// position + yaw (degrees about Y), scale, color.
+struct MeshInstance {
+    float x, y, z, yaw;
+    float sx, sy, sz, pad;
+    float r, g, b, a;
+};
+
+inline MeshVertex makeVertex(float x, float y, float z,
+    float nx, float ny, float nz,
+    float u, float v,
+    float r = 1.0f, float g = 1.0f, float b = 1.0f, float a = 1.0f) {
+    MeshVertex vert = { x, y, z, nx, ny, nz, u, v, r, g, b, a };
+    return vert;
+}
+
+// Appends src to dst with every vertex run through xf.
+void appendMesh(Mesh& dst, const Mesh& src, const MeshTransform& xf);
+
+#endif // MESH_H
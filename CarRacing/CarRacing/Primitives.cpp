@@ -0,0 +1,196 @@
+#include "Primitives.h"
+#include <cmath>
+
+static const float PRIM_PI = 3.14159265358979323846f;
+
+static void pushVertex(Mesh& mesh, const MeshTransform& xf,
+    float x, float y, float z, float nx, float ny, float nz,
+    float u, float v, float r, float g, float b) {
+    xf.transformPoint(x, y, z);
+    xf.transformNormal(nx, ny, nz);
+    mesh.vertices.push_back(makeVertex(x, y, z, nx, ny, nz, u, v, r, g, b));
+}
+
+// ==================== CYLINDER ====================
+void appendCylinder(Mesh& mesh, const MeshTransform& xf,
+    float baseRadius, float topRadius, float height, int slices, int stacks,
+    float r, float g, float b) {
+    if (slices < 3 || stacks < 1) return;
+    mesh.vertices.reserve(mesh.vertices.size() + slices * stacks * 6);
+
+    // Side normal leans by the cone slope, as GLU computes it
+    float dr = baseRadius - topRadius;
+    float len = sqrtf(dr * dr + height * height);
+    float nxy = len > 0.0f ? height / len : 1.0f;
+    float nz = len > 0.0f ? dr / len : 0.0f;
+
+    for (int j = 0; j < stacks; j++) {
+        float t0 = j / (float)stacks;
+        float t1 = (j + 1) / (float)stacks;
+        float r0 = baseRadius + (topRadius - baseRadius) * t0;
+        float r1 = baseRadius + (topRadius - baseRadius) * t1;
+        float z0 = height * t0;
+        float z1 = height * t1;
+
+        for (int i = 0; i < slices; i++) {
+            float a0 = 2.0f * PRIM_PI * i / slices;
+            float a1 = 2.0f * PRIM_PI * (i + 1) / slices;
+            float s0 = sinf(a0), c0 = cosf(a0);
+            float s1 = sinf(a1), c1 = cosf(a1);
+            float u0 = 1.0f - i / (float)slices;
+            float u1 = 1.0f - (i + 1) / (float)slices;
+
+            pushVertex(mesh, xf, r0 * s0, r0 * c0, z0, s0 * nxy, c0 * nxy, nz, u0, t0, r, g, b);
+            pushVertex(mesh, xf, r0 * s1, r0 * c1, z0, s1 * nxy, c1 * nxy, nz, u1, t0, r, g, b);
+            pushVertex(mesh, xf, r1 * s1, r1 * c1, z1, s1 * nxy, c1 * nxy, nz, u1, t1, r, g, b);
+
+            pushVertex(mesh, xf, r0 * s0, r0 * c0, z0, s0 * nxy, c0 * nxy, nz, u0, t0, r, g, b);
+            pushVertex(mesh, xf, r1 * s1, r1 * c1, z1, s1 * nxy, c1 * nxy, nz, u1, t1, r, g, b);
+            pushVertex(mesh, xf, r1 * s0, r1 * c0, z1, s0 * nxy, c0 * nxy, nz, u0, t1, r, g, b);
+        }
+    }
+}
+
+// ==================== DISK ====================
+void appendDisk(Mesh& mesh, const MeshTransform& xf,
+    float innerRadius, float outerRadius, int slices, int loops,
+    float r, float g, float b) {
+    if (slices < 3 || loops < 1) return;
+    mesh.vertices.reserve(mesh.vertices.size() + slices * loops * 6);
+
+    float texScale = outerRadius > 0.0f ? 0.5f / outerRadius : 0.0f;
+    for (int j = 0; j < loops; j++) {
+        float r0 = innerRadius + (outerRadius - innerRadius) * j / loops;
+        float r1 = innerRadius + (outerRadius - innerRadius) * (j + 1) / loops;
+
+        for (int i = 0; i < slices; i++) {
+            float a0 = 2.0f * PRIM_PI * i / slices;
+            float a1 = 2.0f * PRIM_PI * (i + 1) / slices;
+            float s0 = sinf(a0), c0 = cosf(a0);
+            float s1 = sinf(a1), c1 = cosf(a1);
+
+            float x00 = r0 * s0, y00 = r0 * c0;
+            float x01 = r0 * s1, y01 = r0 * c1;
+            float x10 = r1 * s0, y10 = r1 * c0;
+            float x11 = r1 * s1, y11 = r1 * c1;
+
+            pushVertex(mesh, xf, x00, y00, 0.0f, 0, 0, 1, x00 * texScale + 0.5f, y00 * texScale + 0.5f, r, g, b);
+            pushVertex(mesh, xf, x11, y11, 0.0f, 0, 0, 1, x11 * texScale + 0.5f, y11 * texScale + 0.5f, r, g, b);
+            pushVertex(mesh, xf, x01, y01, 0.0f, 0, 0, 1, x01 * texScale + 0.5f, y01 * texScale + 0.5f, r, g, b);
+
+            pushVertex(mesh, xf, x00, y00, 0.0f, 0, 0, 1, x00 * texScale + 0.5f, y00 * texScale + 0.5f, r, g, b);
+            pushVertex(mesh, xf, x10, y10, 0.0f, 0, 0, 1, x10 * texScale + 0.5f, y10 * texScale + 0.5f, r, g, b);
+            pushVertex(mesh, xf, x11, y11, 0.0f, 0, 0, 1, x11 * texScale + 0.5f, y11 * texScale + 0.5f, r, g, b);
+        }
+    }
+}
+
+// ==================== SPHERE ====================
+void appendSphere(Mesh& mesh, const MeshTransform& xf,
+    float radius, int slices, int stacks,
+    float r, float g, float b) {
+    if (slices < 3 || stacks < 2) return;
+    mesh.vertices.reserve(mesh.vertices.size() + slices * stacks * 6);
+
+    for (int j = 0; j < stacks; j++) {
+        float p0 = PRIM_PI * j / stacks;
+        float p1 = PRIM_PI * (j + 1) / stacks;
+        float sp0 = sinf(p0), cp0 = cosf(p0);
+        float sp1 = sinf(p1), cp1 = cosf(p1);
+        float v0 = 1.0f - j / (float)stacks;
+        float v1 = 1.0f - (j + 1) / (float)stacks;
+
+        for (int i = 0; i < slices; i++) {
+            float a0 = 2.0f * PRIM_PI * i / slices;
+            float a1 = 2.0f * PRIM_PI * (i + 1) / slices;
+            float s0 = sinf(a0), c0 = cosf(a0);
+            float s1 = sinf(a1), c1 = cosf(a1);
+            float u0 = 1.0f - i / (float)slices;
+            float u1 = 1.0f - (i + 1) / (float)slices;
+
+            // Unit-sphere positions double as normals
+            float n00x = s0 * sp0, n00y = c0 * sp0, n00z = cp0;
+            float n01x = s1 * sp0, n01y = c1 * sp0, n01z = cp0;
+            float n10x = s0 * sp1, n10y = c0 * sp1, n10z = cp1;
+            float n11x = s1 * sp1, n11y = c1 * sp1, n11z = cp1;
+
+            pushVertex(mesh, xf, n00x * radius, n00y * radius, n00z * radius, n00x, n00y, n00z, u0, v0, r, g, b);
+            pushVertex(mesh, xf, n10x * radius, n10y * radius, n10z * radius, n10x, n10y, n10z, u0, v1, r, g, b);
+            pushVertex(mesh, xf, n11x * radius, n11y * radius, n11z * radius, n11x, n11y, n11z, u1, v1, r, g, b);
+
+            pushVertex(mesh, xf, n00x * radius, n00y * radius, n00z * radius, n00x, n00y, n00z, u0, v0, r, g, b);
+            pushVertex(mesh, xf, n11x * radius, n11y * radius, n11z * radius, n11x, n11y, n11z, u1, v1, r, g, b);
+            pushVertex(mesh, xf, n01x * radius, n01y * radius, n01z * radius, n01x, n01y, n01z, u1, v0, r, g, b);
+        }
+    }
+}
+
+// ==================== TORUS ====================
+void appendTorus(Mesh& mesh, const MeshTransform& xf,
+    float innerRadius, float outerRadius, int sides, int rings,
+    float r, float g, float b) {
+    if (sides < 3 || rings < 3) return;
+    mesh.vertices.reserve(mesh.vertices.size() + sides * rings * 6);
+
+    for (int j = 0; j < rings; j++) {
+        float p0 = 2.0f * PRIM_PI * j / rings;
+        float p1 = 2.0f * PRIM_PI * (j + 1) / rings;
+        float cp0 = cosf(p0), sp0 = sinf(p0);
+        float cp1 = cosf(p1), sp1 = sinf(p1);
+        float u0 = j / (float)rings;
+        float u1 = (j + 1) / (float)rings;
+
+        for (int i = 0; i < sides; i++) {
+            float t0 = 2.0f * PRIM_PI * i / sides;
+            float t1 = 2.0f * PRIM_PI * (i + 1) / sides;
+            float ct0 = cosf(t0), st0 = sinf(t0);
+            float ct1 = cosf(t1), st1 = sinf(t1);
+            float v0 = i / (float)sides;
+            float v1 = (i + 1) / (float)sides;
+
+            // Distance from the Z axis for each tube angle
+            float d0 = outerRadius + innerRadius * ct0;
+            float d1 = outerRadius + innerRadius * ct1;
+            float z0 = innerRadius * st0;
+            float z1 = innerRadius * st1;
+
+            pushVertex(mesh, xf, cp0 * d0, sp0 * d0, z0, cp0 * ct0, sp0 * ct0, st0, u0, v0, r, g, b);
+            pushVertex(mesh, xf, cp1 * d0, sp1 * d0, z0, cp1 * ct0, sp1 * ct0, st0, u1, v0, r, g, b);
+            pushVertex(mesh, xf, cp1 * d1, sp1 * d1, z1, cp1 * ct1, sp1 * ct1, st1, u1, v1, r, g, b);
+
+            pushVertex(mesh, xf, cp0 * d0, sp0 * d0, z0, cp0 * ct0, sp0 * ct0, st0, u0, v0, r, g, b);
+            pushVertex(mesh, xf, cp1 * d1, sp1 * d1, z1, cp1 * ct1, sp1 * ct1, st1, u1, v1, r, g, b);
+            pushVertex(mesh, xf, cp0 * d1, sp0 * d1, z1, cp0 * ct1, sp0 * ct1, st1, u0, v1, r, g, b);
+        }
+    }
+}
+
+// ==================== BOX ====================
+void appendBox(Mesh& mesh, const MeshTransform& xf, float r, float g, float b) {
+    // Per face: normal, then the two in-plane axes the corners are spanned by
+    static const float faces[6][9] = {
+        {  0,  0,  1,   1, 0, 0,   0, 1, 0 }, // +Z (front)
+        {  0,  0, -1,  -1, 0, 0,   0, 1, 0 }, // -Z (back)
+        {  1,  0,  0,   0, 0, -1,  0, 1, 0 }, // +X (right)
+        { -1,  0,  0,   0, 0, 1,   0, 1, 0 }, // -X (left)
+        {  0,  1,  0,   1, 0, 0,   0, 0, -1 }, // +Y (top)
+        {  0, -1,  0,   1, 0, 0,   0, 0, 1 }, // -Y (bottom)
+    };
+    static const float corners[6][2] = {
+        { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 0 }, { 1, 1 }, { 0, 1 }
+    };
+
+    mesh.vertices.reserve(mesh.vertices.size() + 36);
+    for (int f = 0; f < 6; f++) {
+        const float* n = faces[f];
+        const float* uAxis = faces[f] + 3;
+        const float* vAxis = faces[f] + 6;
+        for (int c = 0; c < 6; c++) {
+            float u = corners[c][0], v = corners[c][1];
+            float x = 0.5f * n[0] + (u - 0.5f) * uAxis[0] + (v - 0.5f) * vAxis[0];
+            float y = 0.5f * n[1] + (u - 0.5f) * uAxis[1] + (v - 0.5f) * vAxis[1];
+            float z = 0.5f * n[2] + (u - 0.5f) * uAxis[2] + (v - 0.5f) * vAxis[2];
+            pushVertex(mesh, xf, x, y, z, n[0], n[1], n[2], u, v, r, g, b);
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef PRIMITIVES_H
+#define PRIMITIVES_H
+
+#include "Mesh.h"
+
+// CPU versions of the GLU/GLUT shapes the scene is made of. They follow the
+// same conventions (axis, texcoords, normals) as the calls they replace so
+// existing glTranslatef/glRotatef placements carry over as a MeshTransform.
+// All of them append triangles to mesh.
+
+// gluCylinder: along +Z from z = 0 to z = height.
+void appendCylinder(Mesh& mesh, const MeshTransform& xf,
+    float baseRadius, float topRadius, float height, int slices, int stacks,
+    float r = 1.0f, float g = 1.0f, float b = 1.0f);
+
+// gluDisk: in the z = 0 plane, facing +Z.
+void appendDisk(Mesh& mesh, const MeshTransform& xf,
+    float innerRadius, float outerRadius, int slices, int loops,
+    float r = 1.0f, float g = 1.0f, float b = 1.0f);
+
+// gluSphere / glutSolidSphere: centred on the origin, poles on +/-Z.
+void appendSphere(Mesh& mesh, const MeshTransform& xf,
+    float radius, int slices, int stacks,
+    float r = 1.0f, float g = 1.0f, float b = 1.0f);
+
+// glutSolidTorus: ring in the z = 0 plane around the Z axis. innerRadius is
+// the tube radius, outerRadius the distance from the centre to the tube.
+void appendTorus(Mesh& mesh, const MeshTransform& xf,
+    float innerRadius, float outerRadius, int sides, int rings,
+    float r = 1.0f, float g = 1.0f, float b = 1.0f);
+
+// glutSolidCube(1.0f): unit cube centred on the origin, each face mapped to
+// the full 0..1 texture range.
+void appendBox(Mesh& mesh, const MeshTransform& xf,
+    float r = 1.0f, float g = 1.0f, float b = 1.0f);
+
+#endif // PRIMITIVES_H
@@ -0,0 +1,159 @@
+#include "Profiler.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+
+bool profilerEnabled = false;
+
+static ProfileEvent ring[PROFILE_RING_CAPACITY];
+static int ringNext = 0;   // slot the next event is written to
+static int ringCount = 0;
+static int frameIndex = 0;
+static int cpuDepth = 0;   // open CPU scopes
+
+// Other-thread events; head and tail count events ever handed over and
+// drained, each written by one side only
+static ProfileEvent handoff[PROFILE_HANDOFF_CAPACITY];
+static std::atomic<unsigned> handoffHead{ 0 }; // producer
+static std::atomic<unsigned> handoffTail{ 0 }; // main thread
+
+long long profileNowNs() {
+    return (long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void profileRecord(const char* name, long long startNs, long long durationNs,
+    int track, int depth, int frame) {
+    ProfileEvent& e = ring[ringNext];
+    e.name = name;
+    e.startNs = startNs;
+    e.durationNs = durationNs;
+    e.frame = frame;
+    e.track = track;
+    e.depth = depth;
+
+    ringNext = (ringNext + 1) % PROFILE_RING_CAPACITY;
+    if (ringCount < PROFILE_RING_CAPACITY) ringCount++;
+}
+
+void profileCounter(const char* name, long long value) {
+    if (!profilerEnabled) return;
+    profileRecord(name, profileNowNs(), value, PROFILE_TRACK_COUNTER, 0, frameIndex);
+}
+
+void profileRecordFromThread(const char* name, long long startNs, long long durationNs,
+    int track, int depth) {
+    if (!profilerEnabled) return;
+    unsigned head = handoffHead.load(std::memory_order_relaxed);
+    // acquire: the main thread is done reading the slot about to be reused
+    if (head - handoffTail.load(std::memory_order_acquire) >= (unsigned)PROFILE_HANDOFF_CAPACITY) return;
+    ProfileEvent& e = handoff[head & (PROFILE_HANDOFF_CAPACITY - 1)];
+    e.name = name;
+    e.startNs = startNs;
+    e.durationNs = durationNs;
+    e.track = track;
+    e.depth = depth;
+    handoffHead.store(head + 1, std::memory_order_release);
+}
+
+void profileDrainThreadEvents() {
+    unsigned tail = handoffTail.load(std::memory_order_relaxed);
+    // acquire: events written before head moved are visible
+    unsigned head = handoffHead.load(std::memory_order_acquire);
+    for (; tail != head; tail++) {
+        const ProfileEvent& e = handoff[tail & (PROFILE_HANDOFF_CAPACITY - 1)];
+        profileRecord(e.name, e.startNs, e.durationNs, e.track, e.depth, frameIndex);
+    }
+    handoffTail.store(tail, std::memory_order_release);
+}
+
+void profileNextFrame() {
+    frameIndex++;
+}
+
+int profileFrame() {
+    return frameIndex;
+}
+
+int profileEventCount() {
+    return ringCount;
+}
+
+const ProfileEvent& profileEvent(int i) {
+    int oldest = (ringNext - ringCount + PROFILE_RING_CAPACITY) % PROFILE_RING_CAPACITY;
+    return ring[(oldest + i) % PROFILE_RING_CAPACITY];
+}
+
+void profileClear() {
+    ringNext = 0;
+    ringCount = 0;
+}
+
+// Event names come from code, but keep the JSON valid whatever they hold.
+static void writeJsonString(FILE* f, const char* s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        if ((unsigned char)*s < 0x20) continue;
+        fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+bool writeChromeTrace(const char* path) {
+    profileDrainThreadEvents();
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        printf("Profiler: cannot write trace to %s\n", path);
+        return false;
+    }
+
+    // Timestamps relative to the first event keep the numbers short
+    long long origin = ringCount > 0 ? profileEvent(0).startNs : 0;
+    for (int i = 1; i < ringCount; i++) {
+        if (profileEvent(i).startNs < origin) origin = profileEvent(i).startNs;
+    }
+
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"CPU\"}},\n",
+        PROFILE_TRACK_CPU);
+    fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"GPU\"}},\n",
+        PROFILE_TRACK_GPU);
+    fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"Simulation\"}}",
+        PROFILE_TRACK_SIM);
+
+    for (int i = 0; i < ringCount; i++) {
+        const ProfileEvent& e = profileEvent(i);
+        fprintf(f, ",\n{\"name\":");
+        writeJsonString(f, e.name);
+        if (e.track == PROFILE_TRACK_COUNTER) {
+            fprintf(f, ",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"value\":%lld}}",
+                (e.startNs - origin) / 1000.0, e.durationNs);
+            continue;
+        }
+        fprintf(f, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,"
+            "\"args\":{\"frame\":%d,\"depth\":%d}}",
+            e.track == PROFILE_TRACK_GPU ? "gpu" : "cpu", e.track,
+            (e.startNs - origin) / 1000.0, e.durationNs / 1000.0, e.frame, e.depth);
+    }
+    fprintf(f, "\n]}\n");
+
+    bool ok = ferror(f) == 0;
+    if (fclose(f) != 0) ok = false;
+    if (!ok) printf("Profiler: error while writing %s\n", path);
+    else printf("Profiler: wrote %d events to %s\n", ringCount, path);
+    return ok;
+}
+
+ProfileScope::ProfileScope(const char* scopeName) : name(scopeName), startNs(0), depth(-1) {
+    if (!profilerEnabled) return;
+    depth = cpuDepth++;
+    startNs = profileNowNs();
+}
+
+ProfileScope::~ProfileScope() {
+    if (depth < 0) return;
+    long long endNs = profileNowNs();
+    cpuDepth--;
+    profileRecord(name, startNs, endNs - startNs, PROFILE_TRACK_CPU, depth, frameIndex);
+}
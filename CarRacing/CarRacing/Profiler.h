@@ -0,0 +1,83 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// GL-free frame profiler. Scoped timers record nanosecond CPU timings into
+// a fixed ring buffer (the oldest events are overwritten), which can be
+// dumped as Chrome trace-event JSON for chrome://tracing or Perfetto.
+// GPU timings from GpuProfiler.h and per-frame counters land in the same
+// buffer on tracks of their own. Recording is off until profilerEnabled is
+// set; a disabled scope costs one branch. Main thread only, except that
+// one other thread (the simulation's) can hand its own timings over with
+// profileRecordFromThread().
+
+const int PROFILE_RING_CAPACITY = 1 << 16;
+const int PROFILE_HANDOFF_CAPACITY = 1 << 10; // other-thread events between two drains
+
+// Trace "threads" the events are shown on
+const int PROFILE_TRACK_CPU = 0;
+const int PROFILE_TRACK_GPU = 1;
+const int PROFILE_TRACK_COUNTER = 2; // counter samples, not timed spans
+const int PROFILE_TRACK_SIM = 3;     // the simulation thread
+
+struct ProfileEvent {
+    const char* name;     // must outlive the profiler (string literals)
+    long long startNs;    // profileNowNs() clock
+    long long durationNs; // counters: the sampled value
+    int frame;
+    int track;
+    int depth;            // nesting level within the track
+};
+
+extern bool profilerEnabled; // set before any other thread starts
+
+// Monotonic clock in nanoseconds.
+long long profileNowNs();
+
+// frame is the frame the work was issued in (profileFrame() for CPU work).
+void profileRecord(const char* name, long long startNs, long long durationNs,
+    int track, int depth, int frame);
+
+// Samples a per-frame count (draw calls, state changes) at now; the trace
+// shows each name as a graph.
+void profileCounter(const char* name, long long value);
+
+// Producer side of a single-producer handoff for one thread other than the
+// main one. Events wait there until profileDrainThreadEvents() moves them
+// into the ring; if PROFILE_HANDOFF_CAPACITY are already waiting the event
+// is dropped.
+void profileRecordFromThread(const char* name, long long startNs, long long durationNs,
+    int track, int depth);
+
+// Main thread: moves the handed-over events into the ring, stamped with the
+// current frame. Call once per frame; writeChromeTrace() drains too.
+void profileDrainThreadEvents();
+
+// Advances the frame number stamped on new events. Call once per frame.
+void profileNextFrame();
+int profileFrame();
+
+// Events in recording order, oldest first.
+int profileEventCount();
+const ProfileEvent& profileEvent(int i);
+void profileClear();
+
+// Writes every buffered event as Chrome trace JSON. Returns false (and
+// prints why) if the file cannot be written.
+bool writeChromeTrace(const char* path);
+
+struct ProfileScope {
+    const char* name;
+    long long startNs;
+    int depth;
+
+    explicit ProfileScope(const char* scopeName);
+    ~ProfileScope();
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// Times the rest of the enclosing block on the CPU track.
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+
+#endif // PROFILER_H
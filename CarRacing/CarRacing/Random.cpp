@@ -0,0 +1,51 @@
+#include "Random.h"
+
+uint64_t splitMix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// ==================== PCG32 ====================
+void Pcg32::seed(uint64_t seedValue, uint64_t stream) {
+    state = 0;
+    inc = (stream << 1) | 1u;
+    next();
+    state += seedValue;
+    next();
+}
+
+uint32_t Pcg32::next() {
+    uint64_t old = state;
+    state = old * 6364136223846793005ull + inc;
+    uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rot = (uint32_t)(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31));
+}
+
+// ==================== XOSHIRO128** ====================
+static inline uint32_t rotl32(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+void Xoshiro128::seed(uint64_t seedValue, uint64_t stream) {
+    uint64_t x = seedValue ^ (stream * 0xD1B54A32D192ED03ull);
+    uint64_t a = splitMix64(x);
+    uint64_t b = splitMix64(x);
+    s[0] = (uint32_t)a; s[1] = (uint32_t)(a >> 32);
+    s[2] = (uint32_t)b; s[3] = (uint32_t)(b >> 32);
+    if ((s[0] | s[1] | s[2] | s[3]) == 0) s[0] = 1; // all-zero state is a fixed point
+}
+
+uint32_t Xoshiro128::next() {
+    uint32_t result = rotl32(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl32(s[3], 11);
+    return result;
+}
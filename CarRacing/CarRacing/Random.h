@@ -0,0 +1,63 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+// Small, fast generators for world generation. Unlike rand() they carry
+// no hidden global state and give the same sequence on every platform, so
+// a seed fully determines the world and each subsystem can draw from its
+// own independent stream.
+
+// PCG32 (XSH-RR): 64-bit state, 2^63 selectable streams.
+struct Pcg32 {
+    uint64_t state = 0;
+    uint64_t inc = 1;
+
+    void seed(uint64_t seedValue, uint64_t stream);
+    uint32_t next();
+};
+
+// xoshiro128**: 128-bit state; stream selects a distinct seeding.
+struct Xoshiro128 {
+    uint32_t s[4] = { 1, 2, 3, 4 };
+
+    void seed(uint64_t seedValue, uint64_t stream);
+    uint32_t next();
+};
+
+// Generator used by World.cpp. Build with WORLD_RNG_XOSHIRO to swap.
+#ifdef WORLD_RNG_XOSHIRO
+typedef Xoshiro128 WorldRng;
+#else
+typedef Pcg32 WorldRng;
+#endif
+
+// SplitMix64 step, used to spread seeds before they reach a generator.
+uint64_t splitMix64(uint64_t& x);
+
+// Uniform float in [a, b).
+inline float rngFloat(WorldRng& rng, float a, float b) {
+    // Top 24 bits give every float in [0, 1) an exact representation
+    return a + (rng.next() >> 8) * (1.0f / 16777216.0f) * (b - a);
+}
+
+// Uniform integer in [0, n), n > 0, without modulo bias.
+inline int rngInt(WorldRng& rng, int n) {
+    uint64_t m = (uint64_t)rng.next() * (uint64_t)n;
+    uint32_t low = (uint32_t)m;
+    if (low < (uint32_t)n) {
+        uint32_t threshold = (0u - (uint32_t)n) % (uint32_t)n;
+        while (low < threshold) {
+            m = (uint64_t)rng.next() * (uint64_t)n;
+            low = (uint32_t)m;
+        }
+    }
+    return (int)(m >> 32);
+}
+
+// +1 or -1 with equal probability.
+inline float rngSign(WorldRng& rng) {
+    return (rng.next() & 0x80000000u) ? -1.0f : 1.0f;
+}
+
+#endif // RANDOM_H
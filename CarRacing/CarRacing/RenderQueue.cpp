@@ -0,0 +1,161 @@
+#include "RenderQueue.h"
+#include "GpuProfiler.h"
+#include <algorithm>
+#include <cstring>
+
+// ===== Sort Key =====
+// layer (4 bits) | unlit (1) | texture (27) | mesh (32). Sorting by mesh
+// last keeps repeated draws of one mesh together.
+static uint64_t makeSortKey(RenderLayer layer, const RenderState& state, const GpuMesh* mesh) {
+    uint64_t meshId = 0;
+    if (mesh) meshId = mesh->vao ? mesh->vao : (mesh->vbo ? mesh->vbo : mesh->displayList);
+    return ((uint64_t)layer << 60) |
+        ((uint64_t)(state.lighting ? 0 : 1) << 59) |
+        ((uint64_t)(state.texture & 0x7FFFFFF) << 32) |
+        (meshId & 0xFFFFFFFF);
+}
+
+static RenderItem& pushItem(RenderQueue& queue, RenderLayer layer, const RenderState& state,
+    const GpuMesh* mesh) {
+    queue.order.push_back({ makeSortKey(layer, state, mesh), (uint32_t)queue.items.size() });
+    queue.items.push_back(RenderItem());
+    RenderItem& item = queue.items.back();
+    item.state = state;
+    item.mesh = mesh;
+    item.pass = queue.pass;
+    return item;
+}
+
+void clearRenderQueue(RenderQueue& queue) {
+    queue.items.clear();
+    queue.order.clear();
+    queue.pass = nullptr;
+}
+
+void setRenderPass(RenderQueue& queue, const char* name) {
+    queue.pass = name;
+}
+
+void queueMesh(RenderQueue& queue, RenderLayer layer, const RenderState& state,
+    const GpuMesh& mesh, const MeshTransform* transform, const float* color) {
+    RenderItem& item = pushItem(queue, layer, state, &mesh);
+    if (transform) {
+        item.hasTransform = true;
+        item.transform = *transform;
+    }
+    if (color) {
+        for (int i = 0; i < 4; i++) item.color[i] = color[i];
+    }
+}
+
+void queueInstanced(RenderQueue& queue, RenderLayer layer, const RenderState& state,
+    const GpuMesh& mesh, const InstanceBuffer& instances) {
+    RenderItem& item = pushItem(queue, layer, state, &mesh);
+    item.instances = &instances;
+}
+
+void queueCallback(RenderQueue& queue, RenderLayer layer, const RenderState& state,
+    RenderCallback callback, void* data) {
+    RenderItem& item = pushItem(queue, layer, state, nullptr);
+    item.callback = callback;
+    item.data = data;
+}
+
+// ===== Submission =====
+static void loadTransform(const MeshTransform& xf) {
+    // Row-major 3x4 affine to a column-major GL matrix
+    const float gl[16] = {
+        xf.m[0][0], xf.m[1][0], xf.m[2][0], 0.0f,
+        xf.m[0][1], xf.m[1][1], xf.m[2][1], 0.0f,
+        xf.m[0][2], xf.m[1][2], xf.m[2][2], 0.0f,
+        xf.m[0][3], xf.m[1][3], xf.m[2][3], 1.0f,
+    };
+    glMultMatrixf(gl);
+}
+
+static bool samePass(const char* a, const char* b) {
+    return a == b || (a && b && strcmp(a, b) == 0);
+}
+
+void flushRenderQueue(RenderQueue& queue) {
+    RenderQueueStats& stats = queue.stats;
+    stats = RenderQueueStats();
+    stats.items = (int)queue.items.size();
+    std::sort(queue.order.begin(), queue.order.end());
+
+    // What the GL currently has; the bound texture is unknown at the start
+    // and after anything that binds its own
+    bool lighting = true, texturing = false;
+    GLuint bound = 0;
+    bool boundKnown = false;
+
+    // One profile scope per run of items from the same pass
+    size_t next = 0, count = queue.order.size();
+    while (next < count) {
+        const char* pass = queue.items[queue.order[next].second].pass;
+        GpuProfileScope scope(pass ? pass : "unnamed");
+        for (; next < count; next++) {
+            const RenderItem& item = queue.items[queue.order[next].second];
+            if (!samePass(item.pass, pass)) break;
+
+            if (item.state.lighting != lighting) {
+                if (item.state.lighting) glEnable(GL_LIGHTING);
+                else glDisable(GL_LIGHTING);
+                lighting = item.state.lighting;
+                stats.lightingToggles++;
+            }
+
+            // Instanced draws bind (and then disable) their texture themselves
+            if (item.instances) {
+                drawMeshInstanced(*item.mesh, *item.instances, item.state.texture);
+                if (item.state.texture != 0) {
+                    texturing = false;
+                    bound = item.state.texture;
+                    boundKnown = true;
+                }
+                continue;
+            }
+
+            if (item.state.texture != 0) {
+                if (!texturing) {
+                    glEnable(GL_TEXTURE_2D);
+                    texturing = true;
+                    stats.textureToggles++;
+                }
+                if (!boundKnown || bound != item.state.texture) {
+                    glBindTexture(GL_TEXTURE_2D, item.state.texture);
+                    bound = item.state.texture;
+                    boundKnown = true;
+                    stats.textureBinds++;
+                }
+            }
+            else if (texturing) {
+                glDisable(GL_TEXTURE_2D);
+                texturing = false;
+                stats.textureToggles++;
+            }
+
+            if (item.callback) {
+                item.callback(item.data);
+                texturing = false;
+                boundKnown = false;
+                continue;
+            }
+
+            if (!item.mesh->vertexColors) glColor4fv(item.color);
+            if (item.hasTransform) {
+                glPushMatrix();
+                loadTransform(item.transform);
+                drawMesh(*item.mesh);
+                glPopMatrix();
+            }
+            else {
+                drawMesh(*item.mesh);
+            }
+        }
+    }
+
+    if (texturing) glDisable(GL_TEXTURE_2D);
+    if (!lighting) glEnable(GL_LIGHTING);
+    clearRenderQueue(queue);
+}
@@ -0,0 +1,85 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include "GpuMesh.h"
+#include "InstancedMesh.h"
+#include <cstdint>
+#include <vector>
+
+// Per-frame draw list. Passes queue what they want drawn together with the
+// GL state it needs; flushRenderQueue() sorts the items by a key built from
+// (layer, lighting, texture, mesh) and walks them in order, touching only
+// the state that differs from the previous item. Items with equal keys
+// keep the order they were queued in. Each item carries the name of the
+// pass that queued it, which the flush times on the profiler.
+
+// Coarse draw order. Items in a later layer are always drawn after every
+// item in an earlier one; within a layer only state decides.
+enum RenderLayer {
+    RENDER_LAYER_GROUND,  // ground, track surface and markings
+    RENDER_LAYER_OPAQUE,  // fixed-function scenery and cars
+    RENDER_LAYER_SHADER   // passes that bind their own programs (crowd, trees)
+};
+
+struct RenderState {
+    GLuint texture = 0;   // 0: untextured
+    bool lighting = true;
+};
+
+// Draws something the queue cannot describe (immediate mode, a renderer
+// with its own shader). Called with the item's state applied; it must
+// leave GL_TEXTURE_2D disabled and GL_LIGHTING as it found it.
+typedef void (*RenderCallback)(void* data);
+
+struct RenderItem {
+    const GpuMesh* mesh = nullptr;
+    const InstanceBuffer* instances = nullptr; // with mesh: instanced draw
+    RenderCallback callback = nullptr;
+    void* data = nullptr;
+    RenderState state;
+    float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f }; // for meshes without vertex colors
+    bool hasTransform = false;
+    MeshTransform transform;                      // model matrix, under the view
+    const char* pass = nullptr;                   // profile scope name (string literal)
+};
+
+// State changes made by the last flush; the game records them as trace
+// counters.
+struct RenderQueueStats {
+    int items = 0;
+    int textureBinds = 0;
+    int textureToggles = 0;  // glEnable/glDisable(GL_TEXTURE_2D)
+    int lightingToggles = 0;
+};
+
+struct RenderQueue {
+    std::vector<RenderItem> items;
+    std::vector<std::pair<uint64_t, uint32_t>> order; // sort key, item index
+    RenderQueueStats stats;
+    const char* pass = nullptr; // given to items queued from now on
+};
+
+void clearRenderQueue(RenderQueue& queue);
+
+// Names the items queued after this call for the profiler. The flush opens
+// a CPU/GPU profile scope of that name around each run of consecutive
+// items sharing it; since items are drawn in state order, one pass can
+// show up as several scopes in a frame.
+void setRenderPass(RenderQueue& queue, const char* name);
+
+// transform (optional) places the mesh under the current modelview; color
+// (optional, RGBA) applies when the mesh has no vertex colors.
+void queueMesh(RenderQueue& queue, RenderLayer layer, const RenderState& state,
+    const GpuMesh& mesh, const MeshTransform* transform = nullptr, const float* color = nullptr);
+
+void queueInstanced(RenderQueue& queue, RenderLayer layer, const RenderState& state,
+    const GpuMesh& mesh, const InstanceBuffer& instances);
+
+void queueCallback(RenderQueue& queue, RenderLayer layer, const RenderState& state,
+    RenderCallback callback, void* data = nullptr);
+
+// Sorts and draws every item, then clears the queue. Expects GL_TEXTURE_2D
+// disabled and GL_LIGHTING enabled on entry and leaves them that way.
+void flushRenderQueue(RenderQueue& queue);
+
+#endif // RENDERQUEUE_H
@@ -0,0 +1,163 @@
+#include "Scenery.h"
+#include "Primitives.h"
+#include "Simulation.h"
+#include "World.h"
+#include <cmath>
+
+// ==================== TIRE BARRIERS ====================
+static void addTireStack(std::vector<MeshInstance>& instances,
+    float x, float z, float angle, bool leanInward, float offset) {
+    float rad = angle * M_PI_F / 180.0f;
+    float px = -sinf(rad);
+    float pz = cosf(rad);
+
+    if (leanInward) { px *= -1; pz *= -1; }
+
+    x += px * offset;
+    z += pz * offset;
+
+    for (int h = 0; h < BARRIER_STACK_HEIGHT; h++) {
+        MeshInstance inst;
+        inst.x = x;
+        inst.y = BARRIER_TIRE_RADIUS + h * BARRIER_TIRE_WIDTH;
+        inst.z = z;
+        inst.yaw = angle;
+        inst.sx = inst.sy = inst.sz = 1.0f;
+        inst.pad = 0.0f;
+        float white = (h % 2 == 0) ? 0.0f : 1.0f;
+        inst.r = 1.0f; inst.g = white; inst.b = white; inst.a = 1.0f;
+        instances.push_back(inst);
+    }
+}
+
+static void addEdgeStacks(std::vector<MeshInstance>& instances,
+    const std::vector<std::pair<float, float>>& edge, bool leanInward, float offset) {
+    for (size_t i = 0; i < edge.size(); i++) {
+        size_t next = (i + 1) % edge.size();
+        float dx = edge[next].first - edge[i].first;
+        float dz = edge[next].second - edge[i].second;
+        float segLen = sqrtf(dx * dx + dz * dz);
+        if (segLen == 0.0f) continue;
+        dx /= segLen; dz /= segLen;
+        float angleDeg = atan2f(dz, dx) * 180.0f / M_PI_F;
+
+        int numStacks = (int)(segLen / BARRIER_STACK_SPACING);
+        for (int s = 0; s < numStacks; s++) {
+            float x = edge[i].first + dx * s * BARRIER_STACK_SPACING;
+            float z = edge[i].second + dz * s * BARRIER_STACK_SPACING;
+            addTireStack(instances, x, z, angleDeg, leanInward, offset);
+        }
+    }
+}
+
+void buildTireBarrierInstances(std::vector<MeshInstance>& instances) {
+    instances.clear();
+
+    float innerOffset = 0.2f; // smaller, closer to inner edge
+    float outerOffset = -0.7f; // larger, leaning toward track
+
+    addEdgeStacks(instances, innerTrack, false, innerOffset);
+    addEdgeStacks(instances, outerTrack, true, outerOffset);
+}
+
+// ==================== TREES ====================
+// Slices/stacks per LOD: trunk, canopy cone, top sphere
+static const int treeTessellation[TREE_LOD_LEVELS][6] = {
+    { 16, 4, 20, 10, 16, 16 },
+    { 8, 1, 10, 2, 8, 6 },
+    { 5, 1, 6, 1, 4, 3 },
+};
+
+// Unit tree proportions, from the original drawTree()
+static const float TREE_TRUNK_HEIGHT = 0.08f;
+static const float TREE_CANOPY_HEIGHT = 0.6f;
+static const int TREE_CANOPY_LAYERS = 4;
+static const float TREE_TOP_HEIGHT = TREE_TRUNK_HEIGHT + TREE_CANOPY_HEIGHT * 0.8f;
+
+void buildTreeMeshes(int lod, Mesh& trunk, Mesh& canopy, Mesh& top) {
+    if (lod < 0) lod = 0;
+    if (lod >= TREE_LOD_LEVELS) lod = TREE_LOD_LEVELS - 1;
+    const int* tess = treeTessellation[lod];
+
+    // Z-up quadric space turned to Y-up, as glRotatef(-90, 1, 0, 0) did
+    MeshTransform up;
+    up.rotate(-90.0f, 1.0f, 0.0f, 0.0f);
+
+    // --- Trunk ---
+    trunk.primitive = MESH_TRIANGLES;
+    trunk.useVertexColor = true;
+    trunk.vertices.clear();
+    float baseRadius = 0.3f;
+    float topRadius = 0.25f;
+    appendCylinder(trunk, up, baseRadius, topRadius, TREE_TRUNK_HEIGHT, tess[0], tess[1],
+        0.55f, 0.27f, 0.07f);
+    MeshTransform cap = up;
+    cap.rotate(180.0f, 1.0f, 0.0f, 0.0f);
+    appendDisk(trunk, cap, 0.0f, baseRadius, tess[0], 1, 0.55f, 0.27f, 0.07f);
+
+    // --- Canopy layers ---
+    canopy.primitive = MESH_TRIANGLES;
+    canopy.useVertexColor = true;
+    canopy.vertices.clear();
+    float layerHeight = TREE_CANOPY_HEIGHT / TREE_CANOPY_LAYERS;
+    for (int i = 0; i < TREE_CANOPY_LAYERS; ++i) {
+        float radius = 5.0f - .3f * i;
+        MeshTransform layer = up;
+        layer.translate(0.0f, 0.0f, TREE_TRUNK_HEIGHT + i * layerHeight * 0.8f);
+        appendCylinder(canopy, layer, radius, 0.0f, layerHeight * 1.4f, tess[2], tess[3]);
+    }
+
+    // --- Top sphere (unit radius scale 0.4, placed by its own instance) ---
+    top.primitive = MESH_TRIANGLES;
+    top.useVertexColor = true;
+    top.vertices.clear();
+    appendSphere(top, up, 0.4f, tess[4], tess[5]);
+}
+
+void buildTreeInstances(const Tree& tree, MeshInstance& body, MeshInstance& top) {
+    body.x = tree.x; body.y = 0.0f; body.z = tree.z; body.yaw = 0.0f;
+    body.sx = tree.radius; body.sy = tree.height; body.sz = tree.radius; body.pad = 0.0f;
+    body.r = body.g = body.b = body.a = 1.0f;
+
+    top = body;
+    top.y = tree.height * TREE_TOP_HEIGHT;
+    top.sy = tree.radius;
+}
+
+// ==================== TRACK OBJECTS ====================
+// Sides/rings of the tire stack tori and slices/stacks of the lamp head
+static const int trackObjectTessellation[TRACK_OBJECT_LOD_LEVELS][4] = {
+    { 16, 16, 16, 16 },
+    { 8, 10, 8, 6 },
+    { 5, 6, 5, 3 },
+};
+
+void buildTrackObjectMesh(int type, int lod, Mesh& mesh) {
+    const int* tess = trackObjectTessellation[lod];
+    mesh.primitive = MESH_TRIANGLES;
+    mesh.useVertexColor = true;
+    mesh.vertices.clear();
+
+    switch (type) {
+    case 0: // Tire stack
+        for (int i = 0; i < 3; i++) {
+            appendTorus(mesh, MeshTransform().translate(0.0f, i * 0.5f, 0.0f),
+                0.15f, 0.4f, tess[0], tess[1], 0.1f, 0.1f, 0.1f);
+        }
+        break;
+
+    case 1: // Barrier
+        appendBox(mesh, MeshTransform().scale(2.0f, 1.0f, 0.5f), 0.9f, 0.1f, 0.1f);
+        break;
+
+    case 2: // Lamp post
+        appendBox(mesh, MeshTransform().scale(0.1f, 5.0f, 0.1f), 0.3f, 0.3f, 0.3f);
+        appendSphere(mesh, MeshTransform().translate(0.0f, 2.5f, 0.0f), 0.3f,
+            tess[2], tess[3], 1.0f, 1.0f, 0.8f);
+        break;
+
+    case 3: // Banner
+        appendBox(mesh, MeshTransform().scale(4.0f, 2.0f, 0.2f), 0.0f, 0.0f, 1.0f);
+        break;
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef SCENERY_H
+#define SCENERY_H
+
+#include "Lod.h"
+#include "Mesh.h"
+#include "World.h"
+#include <vector>
+
+// Per-instance placement for the repeated trackside props. Computed once
+// from the generated world; the renderer draws each list with one
+// instanced call of a shared mesh.
+
+// ===== Tire Barriers =====
+const float BARRIER_TIRE_RADIUS = 0.4f;
+const float BARRIER_TIRE_WIDTH = 0.3f;
+const int BARRIER_STACK_HEIGHT = 3;
+const float BARRIER_STACK_SPACING = 2.0f;
+
+// One instance per tire (BARRIER_STACK_HEIGHT per stack) along both track
+// edges, alternating red/white. Instances are placed for a tire mesh whose
+// axis is already turned to point down (-Y) from its top face.
+void buildTireBarrierInstances(std::vector<MeshInstance>& instances);
+
+// ===== Trees =====
+// Tree meshes are built for a unit tree (radius 1, height 1) and scaled per
+// instance by (radius, height, radius). The top sphere would be stretched
+// by that, so it is a separate mesh with its own, uniformly scaled instance.
+const int TREE_LOD_LEVELS = 3;
+const LodDistances TREE_LOD = { TREE_LOD_LEVELS, { 60.0f, 150.0f }, 0.1f };
+
+// Trunk (with bottom cap), layered canopy cones and top sphere at the given
+// level of detail; 0 matches the original tessellation, higher is coarser.
+void buildTreeMeshes(int lod, Mesh& trunk, Mesh& canopy, Mesh& top);
+
+// body places trunk + canopy, top places the sphere.
+void buildTreeInstances(const Tree& tree, MeshInstance& body, MeshInstance& top);
+
+// ===== Track Objects =====
+// One mesh per TrackObject type and level, in the object's local frame
+// (origin on the ground at its position). Tire stack tori and the lamp
+// head get coarser; the box-only types are the same at every level.
+const int TRACK_OBJECT_TYPES = 4;
+const int TRACK_OBJECT_LOD_LEVELS = 3;
+const LodDistances TRACK_OBJECT_LOD = { TRACK_OBJECT_LOD_LEVELS, { 40.0f, 120.0f }, 0.1f };
+
+void buildTrackObjectMesh(int type, int lod, Mesh& mesh);
+
+#endif // SCENERY_H
@@ -0,0 +1,56 @@
+#include "Shader.h"
+#include <cstdio>
+
+static GLuint compileShader(GLenum type, const char* source) {
+    GLuint shader = glExtCreateShader(type);
+    glExtShaderSource(shader, 1, &source, nullptr);
+    glExtCompileShader(shader);
+
+    GLint ok = 0;
+    glExtGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        char log[1024];
+        glExtGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        printf("Shader compile error (%s): %s\n",
+            type == GL_VERTEX_SHADER ? "vertex" : "fragment", log);
+        glExtDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+GLuint createShaderProgram(const char* vertexSource, const char* fragmentSource,
+    const char* const* attribNames, int attribCount, GLuint firstAttrib) {
+    if (!glHasShaders) return 0;
+
+    GLuint vs = compileShader(GL_VERTEX_SHADER, vertexSource);
+    if (vs == 0) return 0;
+    GLuint fs = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+    if (fs == 0) {
+        glExtDeleteShader(vs);
+        return 0;
+    }
+
+    GLuint program = glExtCreateProgram();
+    glExtAttachShader(program, vs);
+    glExtAttachShader(program, fs);
+    for (int i = 0; i < attribCount; i++) {
+        glExtBindAttribLocation(program, firstAttrib + i, attribNames[i]);
+    }
+    glExtLinkProgram(program);
+
+    // The program keeps the compiled stages alive
+    glExtDeleteShader(vs);
+    glExtDeleteShader(fs);
+
+    GLint ok = 0;
+    glExtGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        char log[1024];
+        glExtGetProgramInfoLog(program, sizeof(log), nullptr, log);
+        printf("Shader link error: %s\n", log);
+        glExtDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
@@ -0,0 +1,25 @@
+#ifndef SHADER_H
+#define SHADER_H
+
+#include "GLExtensions.h"
+
+// Compiles and links a GLSL program. attribNames[i] is bound to location
+// firstAttrib + i before linking. Returns 0 (and prints the log) on failure
+// so callers can fall back to the fixed-function path.
+GLuint createShaderProgram(const char* vertexSource, const char* fragmentSource,
+    const char* const* attribNames = nullptr, int attribCount = 0, GLuint firstAttrib = 0);
+
+// GLSL 1.20 helper approximating the fixed-function result for the two
+// lights set up in setupLights(): ambient + diffuse, no specular. Paste into
+// a vertex shader source ahead of main().
+#define GLSL_FIXED_LIGHTING \
+    "vec3 fixedLighting(vec3 eyeNormal, vec3 eyePos) {\n" \
+    "    vec4 light = gl_LightModel.ambient;\n" \
+    "    for (int i = 0; i < 2; i++) {\n" \
+    "        vec3 L = normalize(gl_LightSource[i].position.xyz - eyePos * gl_LightSource[i].position.w);\n" \
+    "        light += gl_LightSource[i].ambient + gl_LightSource[i].diffuse * max(dot(eyeNormal, L), 0.0);\n" \
+    "    }\n" \
+    "    return light.rgb;\n" \
+    "}\n"
+
+#endif // SHADER_H
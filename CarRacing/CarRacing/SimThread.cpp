@@ -0,0 +1,110 @@
+#include "SimThread.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+// ===== Snapshots =====
+SimSnapshot& snapshotForWriting(SnapshotBuffer& buffer) {
+    return buffer.slots[buffer.writing];
+}
+
+void publishSnapshot(SnapshotBuffer& buffer) {
+    // release: the slot's contents are visible to whoever takes it;
+    // acquire: the slot coming back is no longer being read
+    int old = buffer.middle.exchange(buffer.writing | SNAPSHOT_FRESH, std::memory_order_acq_rel);
+    buffer.writing = old & ~SNAPSHOT_FRESH;
+}
+
+const SimSnapshot& latestSnapshot(SnapshotBuffer& buffer) {
+    if (buffer.middle.load(std::memory_order_relaxed) & SNAPSHOT_FRESH) {
+        int old = buffer.middle.exchange(buffer.reading, std::memory_order_acq_rel);
+        buffer.reading = old & ~SNAPSHOT_FRESH;
+    }
+    return buffer.slots[buffer.reading];
+}
+
+float snapshotAlpha(const SimSnapshot& snapshot, long long nowNs) {
+    if (snapshot.stepDt <= 0.0f) return 1.0f;
+    float alpha = (nowNs - snapshot.stepNs) * 1e-9f / snapshot.stepDt;
+    return std::min(std::max(alpha, 0.0f), 1.0f);
+}
+
+// ===== Thread =====
+SimThread::~SimThread() {
+    stopSimThread(*this);
+}
+
+static void publishCars(SimThread& sim, long long stepNs, long long steps) {
+    SimSnapshot& snapshot = snapshotForWriting(sim.snapshots);
+    snapshot.prev = sim.prev;
+    snapshot.cars = sim.cars;
+    snapshot.stepDt = fixedStepDt(sim.clock);
+    snapshot.stepNs = stepNs;
+    snapshot.steps = steps;
+    snapshot.inputNs = sim.inputState.lastEventNs;
+    publishSnapshot(sim.snapshots);
+}
+
+// Before every step: car 0 gets the keys as of the step's start, then the
+// caller's control runs
+static void controlStep(VehicleSet& set, void* data) {
+    SimThread& sim = *(SimThread*)data;
+    unsigned keys = consumeInputEvents(sim.input, sim.inputState, sim.nextStepNs);
+    sim.nextStepNs += (long long)(fixedStepDt(sim.clock) * 1e9f);
+    if (set.count > 0) {
+        CarInput input;
+        input.forward = (keys & SIM_INPUT_FORWARD) != 0;
+        input.backward = (keys & SIM_INPUT_BACKWARD) != 0;
+        input.left = (keys & SIM_INPUT_LEFT) != 0;
+        input.right = (keys & SIM_INPUT_RIGHT) != 0;
+        setVehicleInput(set, 0, input);
+    }
+    if (sim.control) sim.control(set, sim.controlData);
+}
+
+static void simLoop(SimThread& sim) {
+    long long lastNs = profileNowNs();
+    long long totalSteps = 0;
+    while (sim.running.load(std::memory_order_acquire)) {
+        long long nowNs = profileNowNs();
+        float frameTime = (nowNs - lastNs) * 1e-9f;
+        lastNs = nowNs;
+
+        // The steps due now cover the accumulated time up to nowNs
+        sim.nextStepNs = nowNs - (long long)((sim.clock.accumulator + frameTime) * 1e9f);
+        int steps = stepVehiclesFixed(sim.clock, sim.prev, sim.cars, frameTime, sim.track,
+            sim.collision, controlStep, &sim);
+        if (steps > 0) profileRecordFromThread("physics", nowNs, profileNowNs() - nowNs, PROFILE_TRACK_SIM, 0);
+        totalSteps += steps;
+        if (steps > 0) publishCars(sim, nowNs - (long long)(sim.clock.accumulator * 1e9f), totalSteps);
+
+        // Sleep until the next step is due
+        float wait = fixedStepDt(sim.clock) - sim.clock.accumulator;
+        if (wait > 0.0f) std::this_thread::sleep_for(std::chrono::microseconds((long long)(wait * 1e6f)));
+    }
+}
+
+void startSimThread(SimThread& sim) {
+    stopSimThread(sim);
+
+    // The first snapshot is the cars as given, so there is one to read
+    // before the first step
+    publishCars(sim, profileNowNs(), 0);
+
+    sim.running.store(true, std::memory_order_release);
+    sim.thread = std::thread(simLoop, std::ref(sim));
+}
+
+void stopSimThread(SimThread& sim) {
+    sim.running.store(false, std::memory_order_release);
+    if (sim.thread.joinable()) sim.thread.join();
+}
+
+void pushSimInput(SimThread& sim, unsigned key, bool pressed) {
+    InputEvent event;
+    event.timeNs = profileNowNs();
+    event.key = key;
+    event.pressed = pressed;
+    if (!pushInputEvent(sim.input, event) && pressed) printf("Input queue full, key press dropped\n");
+}
@@ -0,0 +1,96 @@
+#ifndef SIMTHREAD_H
+#define SIMTHREAD_H
+
+#include "InputQueue.h"
+#include "Vehicles.h"
+#include <atomic>
+#include <thread>
+
+// Physics on its own thread. The thread steps the cars at the fixed rate
+// on its own wall clock, so a slow frame no longer holds the simulation
+// back (and a slow step no longer holds the frame back). After each batch
+// of steps it publishes a snapshot of the cars through a triple buffer:
+// the renderer always picks up the newest complete one without locks and
+// without ever waiting for the simulation. Player keys come in the other
+// way as timestamped events (InputQueue.h). Each batch of steps shows up
+// as a "physics" scope on the profiler's simulation track. GL-free.
+
+// ===== Snapshots =====
+struct SimSnapshot {
+    VehicleSet prev;           // cars before the last step
+    VehicleSet cars;           // cars after it
+    long long stepNs = 0;      // profileNowNs() the last step was due at
+    float stepDt = 0.0f;
+    long long steps = 0;       // run since the thread started
+    long long inputNs = 0;     // newest input event the cars have seen
+};
+
+// Bit in SnapshotBuffer::middle marking a slot the reader has not taken
+const int SNAPSHOT_FRESH = 4;
+
+// Three slots: one the writer fills, one the reader holds and one in the
+// middle. Publishing swaps the writer's slot with the middle one and
+// reading swaps the middle one with the reader's, each with one atomic
+// exchange, so neither side ever waits for the other. Exactly one writer
+// and one reader thread.
+struct SnapshotBuffer {
+    SimSnapshot slots[3];
+    std::atomic<int> middle{ 1 }; // slot index, | SNAPSHOT_FRESH when unread
+    int writing = 0;              // writer thread only
+    int reading = 2;              // reader thread only
+};
+
+// Slot to fill before publishSnapshot(). Writer thread only.
+SimSnapshot& snapshotForWriting(SnapshotBuffer& buffer);
+
+// Hands the filled slot to the reader. Writer thread only.
+void publishSnapshot(SnapshotBuffer& buffer);
+
+// Newest published snapshot; stays valid until the next call. Reader
+// thread only.
+const SimSnapshot& latestSnapshot(SnapshotBuffer& buffer);
+
+// How far the display is from snapshot.prev to snapshot.cars at nowNs:
+// snapshots are shown one step late, blending over the step after each
+// one was due.
+float snapshotAlpha(const SimSnapshot& snapshot, long long nowNs);
+
+// ===== Thread =====
+// Player key bits in SimThread::input events
+const unsigned SIM_INPUT_FORWARD = 1;
+const unsigned SIM_INPUT_BACKWARD = 2;
+const unsigned SIM_INPUT_LEFT = 4;
+const unsigned SIM_INPUT_RIGHT = 8;
+
+struct SimThread {
+    std::thread thread;
+    std::atomic<bool> running{ false };
+
+    // Set up before startSimThread(); the thread's own while it runs
+    FixedStepClock clock;
+    VehicleSet cars;
+    VehicleSet prev;
+    const TrackIndex* track = nullptr;
+    const CollisionWorld* collision = nullptr;
+    VehicleControlFunc control = nullptr;
+    void* controlData = nullptr;
+
+    InputQueue input;                 // car 0's keys, SIM_INPUT_* bits
+    InputState inputState;            // the thread's own
+    long long nextStepNs = 0;         // the thread's own: when the next step starts
+    SnapshotBuffer snapshots;
+
+    ~SimThread();
+};
+
+// Publishes the cars as they are, then starts stepping them.
+void startSimThread(SimThread& sim);
+
+// Joins the thread; the cars are the caller's again afterwards.
+void stopSimThread(SimThread& sim);
+
+// Queues a press or release of a SIM_INPUT_* key for car 0, stamped now;
+// the step it falls in applies it. One thread only (the window's).
+void pushSimInput(SimThread& sim, unsigned key, bool pressed);
+
+#endif // SIMTHREAD_H
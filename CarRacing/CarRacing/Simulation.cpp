@@ -0,0 +1,127 @@
+#include "Simulation.h"
+#include "World.h"
+#include "TrackQuery.h"
+#include <algorithm>
+#include <cmath>
+
+// ==================== CAR MOVEMENT ====================
+void resetCar(CarState& car) {
+    // Place car on the start line
+    car.x = startLineCenter.first;
+    car.z = startLineCenter.second;
+    car.angle = startLineAngle; // face along track direction
+    car.speed = 0.0f;
+
+    car.tireRotation = 0.0f; // reset wheel rotation if needed
+}
+
+void updateCar(CarState& car, const CarInput& input, float deltaTime) {
+    // --- Update car speed ---
+    if (input.forward) {
+        car.speed += ACCELERATION * deltaTime;
+        if (car.speed > MAX_SPEED_FW) car.speed = MAX_SPEED_FW;
+    }
+    else if (input.backward) {
+        car.speed -= ACCELERATION * deltaTime;
+        if (car.speed < -MAX_SPEED_BW) car.speed = -MAX_SPEED_BW;
+    }
+    else {
+        if (car.speed > 0.0f) {
+            car.speed -= FRICTION * deltaTime;
+            if (car.speed < 0.0f) car.speed = 0.0f;
+        }
+        else if (car.speed < 0.0f) {
+            car.speed += FRICTION * deltaTime;
+            if (car.speed > 0.0f) car.speed = 0.0f;
+        }
+    }
+
+    // --- Update car rotation ---
+    float turnSpeed = TURN_ANGLE * deltaTime;
+    if (input.left) car.angle += turnSpeed;
+    if (input.right) car.angle -= turnSpeed;
+    if (car.angle > 180.0f) car.angle -= 360.0f;
+    if (car.angle < -180.0f) car.angle += 360.0f;
+
+    // --- Update car position ---
+    float rad = car.angle * M_PI_F / 180.0f;
+    float distance = car.speed * deltaTime;
+    car.x += distance * sinf(rad);
+    car.z += distance * cosf(rad);
+
+    // --- Update tire rotation ---
+    float wheelCircumference = 2.0f * M_PI_F * WHEEL_RADIUS;
+    float rotationDelta = (distance / wheelCircumference) * 360.0f; // degrees
+    car.tireRotation += rotationDelta; // don't multiply by deltaTime or 50
+    if (car.tireRotation > 360.0f) car.tireRotation -= 360.0f;
+    if (car.tireRotation < -360.0f) car.tireRotation += 360.0f;
+}
+
+void applyOffTrackDrag(CarState& car, float deltaTime) {
+    float drop = OFF_TRACK_DRAG * deltaTime;
+    if (car.speed > OFF_TRACK_MAX_SPEED) {
+        car.speed -= drop;
+        if (car.speed < OFF_TRACK_MAX_SPEED) car.speed = OFF_TRACK_MAX_SPEED;
+    }
+    else if (car.speed < -OFF_TRACK_MAX_SPEED) {
+        car.speed += drop;
+        if (car.speed > -OFF_TRACK_MAX_SPEED) car.speed = -OFF_TRACK_MAX_SPEED;
+    }
+}
+
+// ==================== FIXED TIMESTEP ====================
+void setFixedStepRate(FixedStepClock& clock, float stepHz) {
+    clock.stepHz = stepHz;
+    clock.maxSubsteps = std::max(1, (int)ceilf(FIXED_STEP_MAX_CATCHUP * stepHz));
+}
+
+float fixedStepDt(const FixedStepClock& clock) {
+    return 1.0f / clock.stepHz;
+}
+
+float fixedStepAlpha(const FixedStepClock& clock) {
+    float alpha = clock.accumulator / fixedStepDt(clock);
+    return alpha > 1.0f ? 1.0f : alpha;
+}
+
+int stepCarFixed(FixedStepClock& clock, CarState& prevCar, CarState& car,
+    const CarInput& input, float frameTime, const TrackIndex* track) {
+    float dt = fixedStepDt(clock);
+    if (frameTime < 0.0f) frameTime = 0.0f;
+    clock.accumulator += frameTime;
+
+    int steps = 0;
+    while (clock.accumulator >= dt && steps < clock.maxSubsteps) {
+        prevCar = car;
+        updateCar(car, input, dt);
+        if (track && !track->segments.empty() && !queryTrack(*track, car.x, car.z).onTrack) {
+            applyOffTrackDrag(car, dt);
+        }
+        clock.accumulator -= dt;
+        steps++;
+    }
+
+    // Over budget: drop the backlog rather than paying for it next frame.
+    if (steps == clock.maxSubsteps && clock.accumulator >= dt) {
+        clock.accumulator = 0.0f;
+    }
+    return steps;
+}
+
+// Shortest-path blend for angles in degrees.
+static float lerpAngle(float a, float b, float alpha) {
+    float diff = b - a;
+    while (diff > 180.0f) diff -= 360.0f;
+    while (diff < -180.0f) diff += 360.0f;
+    return a + diff * alpha;
+}
+
+CarState interpolateCar(const CarState& prevCar, const CarState& car, float alpha) {
+    CarState out = car;
+    out.x = prevCar.x + (car.x - prevCar.x) * alpha;
+    out.z = prevCar.z + (car.z - prevCar.z) * alpha;
+    out.angle = lerpAngle(prevCar.angle, car.angle, alpha);
+    out.speed = prevCar.speed + (car.speed - prevCar.speed) * alpha;
+    out.tireRotation = lerpAngle(prevCar.tireRotation, car.tireRotation, alpha);
+    return out;
+}
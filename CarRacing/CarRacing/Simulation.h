@@ -0,0 +1,81 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+// GL-free car simulation. Everything in here can be driven from the GLUT
+// game or from the headless benchmark without opening a window.
+
+// ===== Track Parameters =====
+const float TRACK_WIDTH = 12.0f;   // constant track width
+
+// ===== Constants =====
+const float MAX_SPEED_FW = 30.0f;
+const float MAX_SPEED_BW = 30.0f;
+const float ACCELERATION = 20.0f;
+const float TURN_ANGLE = 90.0f;
+const float FRICTION = 8.0f;
+const float WHEEL_RADIUS = 0.3f;
+const float M_PI_F = 3.14159265358979323846f;
+const float OFF_TRACK_MAX_SPEED = 12.0f; // grass slows the car towards this
+const float OFF_TRACK_DRAG = 25.0f;      // speed lost per second above it
+
+struct TrackIndex;
+
+// ===== Car State =====
+struct CarState {
+    float x = 50.0f, z = 50.0f;
+    float angle = 0.0f;        // degrees, 0 = facing +Z
+    float speed = 10.0f;
+    float tireRotation = 0.0f; // in degrees
+};
+
+// ===== Movement Flags =====
+struct CarInput {
+    bool forward = false;
+    bool backward = false;
+    bool left = false;
+    bool right = false;
+};
+
+// ===== Fixed Timestep =====
+// Physics runs at a fixed rate; each rendered frame adds its wall-clock time
+// to the accumulator and consumes it in whole steps. At most maxSubsteps run
+// per frame so a long stall cannot snowball into ever longer frames.
+const float FIXED_STEP_MAX_CATCHUP = 0.1f; // seconds of simulated time per frame, at most
+
+struct FixedStepClock {
+    float stepHz = 120.0f;
+    int maxSubsteps = 12;      // FIXED_STEP_MAX_CATCHUP at stepHz; set both with setFixedStepRate()
+    float accumulator = 0.0f;
+};
+
+// Sets the step rate, and maxSubsteps to the steps in FIXED_STEP_MAX_CATCHUP
+// at that rate (at least one).
+void setFixedStepRate(FixedStepClock& clock, float stepHz);
+
+float fixedStepDt(const FixedStepClock& clock);
+
+// Fraction of a step left in the accumulator, used to blend the previous and
+// current states for display.
+float fixedStepAlpha(const FixedStepClock& clock);
+
+// Advances the car by every whole step available after adding frameTime.
+// prevCar receives the state before the last step taken. With a track
+// index, steps that end off the track apply grass drag. Returns the number
+// of steps run.
+int stepCarFixed(FixedStepClock& clock, CarState& prevCar, CarState& car,
+    const CarInput& input, float frameTime, const TrackIndex* track = nullptr);
+
+// Blend of two car states for rendering between physics steps.
+CarState interpolateCar(const CarState& prevCar, const CarState& car, float alpha);
+
+// Place the car on the start line, facing along the track.
+void resetCar(CarState& car);
+
+// Integrate one step of acceleration/friction, steering, position and
+// wheel rotation.
+void updateCar(CarState& car, const CarInput& input, float deltaTime);
+
+// Slows a car that is off the track down towards OFF_TRACK_MAX_SPEED.
+void applyOffTrackDrag(CarState& car, float deltaTime);
+
+#endif // SIMULATION_H
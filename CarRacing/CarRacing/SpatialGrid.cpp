@@ -0,0 +1,152 @@
+#include "SpatialGrid.h"
+#include "World.h"
+#include <algorithm>
+#include <cmath>
+
+// Largest extents of each item type relative to its position, taken from
+// the draw code in main.cpp and the Scenery/Crowd meshes.
+static const float TRACK_OBJECT_HALF_WIDTH = 2.0f;  // banner is 4 wide
+static const float TRACK_OBJECT_HEIGHT = 3.0f;      // lamp head at 2.5 + 0.3
+static const float TREE_CANOPY_SPREAD = 5.0f;       // widest cone, in tree radii
+static const float PERSON_HALF_WIDTH = 0.6f;
+static const float PERSON_BELOW = 1.6f;             // legs hang below baseY
+static const float PERSON_ABOVE = 1.6f + 0.5f;      // head plus jump height
+
+static SceneryItem makeItem(int kind, int index, float x, float z, float halfX, float halfZ,
+    float minY, float maxY) {
+    SceneryItem item;
+    item.bounds.minX = x - halfX; item.bounds.maxX = x + halfX;
+    item.bounds.minZ = z - halfZ; item.bounds.maxZ = z + halfZ;
+    item.bounds.minY = minY; item.bounds.maxY = maxY;
+    item.kind = kind;
+    item.index = index;
+    return item;
+}
+
+void gatherSceneryItems(std::vector<SceneryItem>& items) {
+    items.clear();
+    items.reserve(buildings.size() + stands.size() + trees.size() +
+        trackObjects.size() + audience.size());
+
+    for (size_t i = 0; i < buildings.size(); i++) {
+        const Building& b = buildings[i];
+        float height = b.height - 5.0f; // drawBuildings() trims 5 units
+        items.push_back(makeItem(SCENERY_BUILDING, (int)i, b.x, b.z,
+            b.width * 0.5f, b.depth * 0.5f, std::min(0.0f, height), std::max(0.0f, height)));
+    }
+    for (size_t i = 0; i < stands.size(); i++) {
+        const Stand& s = stands[i];
+        // Base cube is centred on the ground, roof overhangs by 1 each side
+        items.push_back(makeItem(SCENERY_STAND, (int)i, s.x, s.z,
+            s.width * 0.5f + 1.0f, s.depth * 0.5f + 1.0f, -s.height * 0.5f, s.height * 0.5f + 1.0f));
+    }
+    for (size_t i = 0; i < trees.size(); i++) {
+        const Tree& t = trees[i];
+        float spread = t.radius * TREE_CANOPY_SPREAD;
+        items.push_back(makeItem(SCENERY_TREE, (int)i, t.x, t.z,
+            spread, spread, 0.0f, t.height + t.radius * 0.4f));
+    }
+    for (size_t i = 0; i < trackObjects.size(); i++) {
+        const TrackObject& o = trackObjects[i];
+        items.push_back(makeItem(SCENERY_TRACK_OBJECT, (int)i, o.x, o.z,
+            TRACK_OBJECT_HALF_WIDTH, TRACK_OBJECT_HALF_WIDTH, -0.5f, TRACK_OBJECT_HEIGHT));
+    }
+    for (size_t i = 0; i < audience.size(); i++) {
+        const Person& p = audience[i];
+        items.push_back(makeItem(SCENERY_PERSON, (int)i, p.x, p.z,
+            PERSON_HALF_WIDTH, PERSON_HALF_WIDTH, p.baseY - PERSON_BELOW, p.baseY + PERSON_ABOVE));
+    }
+}
+
+static int cellOf(const SpatialGrid& grid, const SceneryBounds& b) {
+    float cx = (b.minX + b.maxX) * 0.5f;
+    float cz = (b.minZ + b.maxZ) * 0.5f;
+    int ix = (int)((cx - grid.originX) / grid.cellSize);
+    int iz = (int)((cz - grid.originZ) / grid.cellSize);
+    ix = std::min(std::max(ix, 0), grid.cellsX - 1);
+    iz = std::min(std::max(iz, 0), grid.cellsZ - 1);
+    return iz * grid.cellsX + ix;
+}
+
+void buildSpatialGrid(SpatialGrid& grid, const std::vector<SceneryItem>& items, float cellSize) {
+    grid.cellSize = cellSize;
+    grid.items.clear();
+    grid.cellStart.clear();
+    grid.cellBounds.clear();
+
+    if (items.empty()) {
+        grid.cellsX = grid.cellsZ = 0;
+        grid.cellStart.push_back(0);
+        return;
+    }
+
+    // Grid covers the item centres
+    float minX = 1e30f, maxX = -1e30f, minZ = 1e30f, maxZ = -1e30f;
+    for (const SceneryItem& item : items) {
+        float cx = (item.bounds.minX + item.bounds.maxX) * 0.5f;
+        float cz = (item.bounds.minZ + item.bounds.maxZ) * 0.5f;
+        minX = std::min(minX, cx); maxX = std::max(maxX, cx);
+        minZ = std::min(minZ, cz); maxZ = std::max(maxZ, cz);
+    }
+    grid.originX = minX;
+    grid.originZ = minZ;
+    grid.cellsX = (int)((maxX - minX) / cellSize) + 1;
+    grid.cellsZ = (int)((maxZ - minZ) / cellSize) + 1;
+    int cellCount = grid.cellsX * grid.cellsZ;
+
+    // Counting sort by cell
+    std::vector<int> cells(items.size());
+    grid.cellStart.assign(cellCount + 1, 0);
+    for (size_t i = 0; i < items.size(); i++) {
+        cells[i] = cellOf(grid, items[i].bounds);
+        grid.cellStart[cells[i] + 1]++;
+    }
+    for (int c = 0; c < cellCount; c++) grid.cellStart[c + 1] += grid.cellStart[c];
+
+    std::vector<int> fill(grid.cellStart.begin(), grid.cellStart.end() - 1);
+    grid.items.resize(items.size());
+    for (size_t i = 0; i < items.size(); i++) {
+        grid.items[fill[cells[i]]++] = items[i];
+    }
+
+    SceneryBounds empty = { 1e30f, 1e30f, 1e30f, -1e30f, -1e30f, -1e30f };
+    grid.cellBounds.assign(cellCount, empty);
+    for (int c = 0; c < cellCount; c++) {
+        SceneryBounds& cb = grid.cellBounds[c];
+        for (int i = grid.cellStart[c]; i < grid.cellStart[c + 1]; i++) {
+            const SceneryBounds& b = grid.items[i].bounds;
+            cb.minX = std::min(cb.minX, b.minX); cb.maxX = std::max(cb.maxX, b.maxX);
+            cb.minY = std::min(cb.minY, b.minY); cb.maxY = std::max(cb.maxY, b.maxY);
+            cb.minZ = std::min(cb.minZ, b.minZ); cb.maxZ = std::max(cb.maxZ, b.maxZ);
+        }
+    }
+}
+
+void buildSceneryGrid(SpatialGrid& grid, float cellSize) {
+    std::vector<SceneryItem> items;
+    gatherSceneryItems(items);
+    buildSpatialGrid(grid, items, cellSize);
+}
+
+void cullSpatialGrid(const SpatialGrid& grid, const Frustum& frustum, VisibleScenery& visible) {
+    for (int k = 0; k < SCENERY_KIND_COUNT; k++) visible.indices[k].clear();
+
+    int cellCount = grid.cellsX * grid.cellsZ;
+    for (int c = 0; c < cellCount; c++) {
+        int begin = grid.cellStart[c], end = grid.cellStart[c + 1];
+        if (begin == end) continue;
+
+        const SceneryBounds& cb = grid.cellBounds[c];
+        if (!aabbInFrustum(frustum, cb.minX, cb.minY, cb.minZ, cb.maxX, cb.maxY, cb.maxZ)) continue;
+
+        // Whole cell inside: take every item without testing it
+        bool inside = aabbInsideFrustum(frustum, cb.minX, cb.minY, cb.minZ, cb.maxX, cb.maxY, cb.maxZ);
+        for (int i = begin; i < end; i++) {
+            const SceneryItem& item = grid.items[i];
+            const SceneryBounds& b = item.bounds;
+            if (inside || aabbInFrustum(frustum, b.minX, b.minY, b.minZ, b.maxX, b.maxY, b.maxZ)) {
+                visible.indices[item.kind].push_back(item.index);
+            }
+        }
+    }
+}
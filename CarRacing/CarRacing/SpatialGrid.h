@@ -0,0 +1,62 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "Frustum.h"
+#include <vector>
+
+// Uniform grid over the ground plane holding the bounds of every static
+// scenery item. Built once after world generation; each frame whole cells
+// are tested against the view frustum and only items in cells that straddle
+// a plane are tested individually.
+
+enum SceneryKind {
+    SCENERY_BUILDING,
+    SCENERY_STAND,
+    SCENERY_TREE,
+    SCENERY_TRACK_OBJECT,
+    SCENERY_PERSON,
+    SCENERY_KIND_COUNT
+};
+
+struct SceneryBounds {
+    float minX, minY, minZ;
+    float maxX, maxY, maxZ;
+};
+
+struct SceneryItem {
+    SceneryBounds bounds;
+    int kind;   // SceneryKind
+    int index;  // into the matching World.h vector
+};
+
+struct SpatialGrid {
+    float originX = 0.0f, originZ = 0.0f;
+    float cellSize = 32.0f;
+    int cellsX = 0, cellsZ = 0;
+
+    std::vector<SceneryItem> items;        // sorted by cell
+    std::vector<int> cellStart;            // items of cell c: [cellStart[c], cellStart[c + 1])
+    std::vector<SceneryBounds> cellBounds; // union of the bounds of the items in each cell
+};
+
+// Indices into the World.h vectors, one list per SceneryKind.
+struct VisibleScenery {
+    std::vector<int> indices[SCENERY_KIND_COUNT];
+};
+
+// Items are binned by the centre of their bounds; a cell's bounds grow to
+// cover everything binned into it, so large items need no duplication.
+void buildSpatialGrid(SpatialGrid& grid, const std::vector<SceneryItem>& items,
+    float cellSize = 32.0f);
+
+// Bounds of buildings, stands, trees, track objects and the audience as
+// they are drawn, from the generated world.
+void gatherSceneryItems(std::vector<SceneryItem>& items);
+
+// gatherSceneryItems() + buildSpatialGrid(). Call whenever the world is
+// regenerated.
+void buildSceneryGrid(SpatialGrid& grid, float cellSize = 32.0f);
+
+void cullSpatialGrid(const SpatialGrid& grid, const Frustum& frustum, VisibleScenery& visible);
+
+#endif // SPATIALGRID_H
@@ -0,0 +1,160 @@
+#include "SplineBatch.h"
+#include <cmath>
+#include <vector>
+
+// ===== Kernel primitives =====
+// Every kernel below is written once against these; on the scalar build
+// SimdF is a plain float and the "vector" loops run one lane at a time.
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SPLINE_SIMD_ISA "avx"
+typedef __m256 SimdF;
+static const size_t SIMD_WIDTH = 8;
+static inline SimdF simdSet1(float v) { return _mm256_set1_ps(v); }
+static inline SimdF simdLoad(const float* p) { return _mm256_loadu_ps(p); }
+static inline void simdStore(float* p, SimdF v) { _mm256_storeu_ps(p, v); }
+static inline SimdF simdAdd(SimdF a, SimdF b) { return _mm256_add_ps(a, b); }
+static inline SimdF simdMul(SimdF a, SimdF b) { return _mm256_mul_ps(a, b); }
+static inline SimdF simdSqrt(SimdF a) { return _mm256_sqrt_ps(a); }
+#if defined(__FMA__)
+static inline SimdF simdMulAdd(SimdF a, SimdF b, SimdF c) { return _mm256_fmadd_ps(a, b, c); }
+#else
+static inline SimdF simdMulAdd(SimdF a, SimdF b, SimdF c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+#endif
+
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SPLINE_SIMD_ISA "sse2"
+typedef __m128 SimdF;
+static const size_t SIMD_WIDTH = 4;
+static inline SimdF simdSet1(float v) { return _mm_set1_ps(v); }
+static inline SimdF simdLoad(const float* p) { return _mm_loadu_ps(p); }
+static inline void simdStore(float* p, SimdF v) { _mm_storeu_ps(p, v); }
+static inline SimdF simdAdd(SimdF a, SimdF b) { return _mm_add_ps(a, b); }
+static inline SimdF simdMul(SimdF a, SimdF b) { return _mm_mul_ps(a, b); }
+static inline SimdF simdSqrt(SimdF a) { return _mm_sqrt_ps(a); }
+static inline SimdF simdMulAdd(SimdF a, SimdF b, SimdF c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SPLINE_SIMD_ISA "neon"
+typedef float32x4_t SimdF;
+static const size_t SIMD_WIDTH = 4;
+static inline SimdF simdSet1(float v) { return vdupq_n_f32(v); }
+static inline SimdF simdLoad(const float* p) { return vld1q_f32(p); }
+static inline void simdStore(float* p, SimdF v) { vst1q_f32(p, v); }
+static inline SimdF simdAdd(SimdF a, SimdF b) { return vaddq_f32(a, b); }
+static inline SimdF simdMul(SimdF a, SimdF b) { return vmulq_f32(a, b); }
+static inline SimdF simdSqrt(SimdF a) { return vsqrtq_f32(a); }
+static inline SimdF simdMulAdd(SimdF a, SimdF b, SimdF c) { return vfmaq_f32(c, a, b); }
+
+#else
+#define SPLINE_SIMD_ISA "scalar"
+typedef float SimdF;
+static const size_t SIMD_WIDTH = 1;
+static inline SimdF simdSet1(float v) { return v; }
+static inline SimdF simdLoad(const float* p) { return *p; }
+static inline void simdStore(float* p, SimdF v) { *p = v; }
+static inline SimdF simdAdd(SimdF a, SimdF b) { return a + b; }
+static inline SimdF simdMul(SimdF a, SimdF b) { return a * b; }
+static inline SimdF simdSqrt(SimdF a) { return sqrtf(a); }
+static inline SimdF simdMulAdd(SimdF a, SimdF b, SimdF c) { return a * b + c; }
+#endif
+
+bool splineSimdEnabled = true;
+
+const char* splineSimdIsa() {
+    return splineSimdEnabled ? SPLINE_SIMD_ISA : "scalar";
+}
+
+// ===== Span evaluation =====
+void evaluateSpanBatch(const TrackSplineSpan& s, const float* t, size_t count,
+    float* outX, float* outZ) {
+    size_t i = 0;
+    if (splineSimdEnabled) {
+        SimdF ax = simdSet1(s.ax), bx = simdSet1(s.bx), cx = simdSet1(s.cx), dx = simdSet1(s.dx);
+        SimdF az = simdSet1(s.az), bz = simdSet1(s.bz), cz = simdSet1(s.cz), dz = simdSet1(s.dz);
+        for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH) {
+            SimdF tv = simdLoad(t + i);
+            simdStore(outX + i, simdMulAdd(simdMulAdd(simdMulAdd(dx, tv, cx), tv, bx), tv, ax));
+            simdStore(outZ + i, simdMulAdd(simdMulAdd(simdMulAdd(dz, tv, cz), tv, bz), tv, az));
+        }
+    }
+    for (; i < count; i++) {
+        float tv = t[i];
+        outX[i] = s.ax + tv * (s.bx + tv * (s.cx + tv * s.dx));
+        outZ[i] = s.az + tv * (s.bz + tv * (s.cz + tv * s.dz));
+    }
+}
+
+void spanSpeedBatch(const TrackSplineSpan& s, const float* t, size_t count, float* outSpeed) {
+    // dP/dt = b + 2c t + 3d t^2
+    float cx2 = 2.0f * s.cx, dx3 = 3.0f * s.dx;
+    float cz2 = 2.0f * s.cz, dz3 = 3.0f * s.dz;
+
+    size_t i = 0;
+    if (splineSimdEnabled) {
+        SimdF bx = simdSet1(s.bx), cx = simdSet1(cx2), dx = simdSet1(dx3);
+        SimdF bz = simdSet1(s.bz), cz = simdSet1(cz2), dz = simdSet1(dz3);
+        for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH) {
+            SimdF tv = simdLoad(t + i);
+            SimdF vx = simdMulAdd(simdMulAdd(dx, tv, cx), tv, bx);
+            SimdF vz = simdMulAdd(simdMulAdd(dz, tv, cz), tv, bz);
+            simdStore(outSpeed + i, simdSqrt(simdMulAdd(vx, vx, simdMul(vz, vz))));
+        }
+    }
+    for (; i < count; i++) {
+        float tv = t[i];
+        float vx = s.bx + tv * (cx2 + tv * dx3);
+        float vz = s.bz + tv * (cz2 + tv * dz3);
+        outSpeed[i] = sqrtf(vx * vx + vz * vz);
+    }
+}
+
+// ===== Loop tessellation =====
+// The basis weights only depend on t, so they are computed once per call and
+// each span is four broadcast multiply-adds per coordinate per vector.
+void tessellateCatmullRomLoop(const float* controlX, const float* controlZ, size_t n,
+    int stepsPerSpan, float* outX, float* outZ) {
+    if (n < 2 || stepsPerSpan < 1) return;
+    size_t steps = (size_t)stepsPerSpan;
+
+    std::vector<float> weights(4 * steps);
+    float* w0 = &weights[0];
+    float* w1 = w0 + steps;
+    float* w2 = w1 + steps;
+    float* w3 = w2 + steps;
+    for (size_t k = 0; k < steps; k++) {
+        float t = k / (float)steps;
+        float t2 = t * t, t3 = t2 * t;
+        w0[k] = 0.5f * (-t3 + 2.0f * t2 - t);
+        w1[k] = 0.5f * (3.0f * t3 - 5.0f * t2 + 2.0f);
+        w2[k] = 0.5f * (-3.0f * t3 + 4.0f * t2 + t);
+        w3[k] = 0.5f * (t3 - t2);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        size_t i0 = (i + n - 1) % n, i2 = (i + 1) % n, i3 = (i + 2) % n;
+        float x0 = controlX[i0], x1 = controlX[i], x2 = controlX[i2], x3 = controlX[i3];
+        float z0 = controlZ[i0], z1 = controlZ[i], z2 = controlZ[i2], z3 = controlZ[i3];
+        float* spanX = outX + i * steps;
+        float* spanZ = outZ + i * steps;
+
+        size_t k = 0;
+        if (splineSimdEnabled) {
+            SimdF vx0 = simdSet1(x0), vx1 = simdSet1(x1), vx2 = simdSet1(x2), vx3 = simdSet1(x3);
+            SimdF vz0 = simdSet1(z0), vz1 = simdSet1(z1), vz2 = simdSet1(z2), vz3 = simdSet1(z3);
+            for (; k + SIMD_WIDTH <= steps; k += SIMD_WIDTH) {
+                SimdF a = simdLoad(w0 + k), b = simdLoad(w1 + k);
+                SimdF c = simdLoad(w2 + k), d = simdLoad(w3 + k);
+                simdStore(spanX + k, simdMulAdd(d, vx3, simdMulAdd(c, vx2, simdMulAdd(b, vx1, simdMul(a, vx0)))));
+                simdStore(spanZ + k, simdMulAdd(d, vz3, simdMulAdd(c, vz2, simdMulAdd(b, vz1, simdMul(a, vz0)))));
+            }
+        }
+        for (; k < steps; k++) {
+            spanX[k] = w0[k] * x0 + w1[k] * x1 + w2[k] * x2 + w3[k] * x3;
+            spanZ[k] = w0[k] * z0 + w1[k] * z1 + w2[k] * z2 + w3[k] * z3;
+        }
+    }
+}
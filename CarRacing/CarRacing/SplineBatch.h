@@ -0,0 +1,32 @@
+#ifndef SPLINEBATCH_H
+#define SPLINEBATCH_H
+
+#include "TrackSpline.h"
+#include <cstddef>
+
+// Batch Catmull-Rom evaluation over SoA x/z arrays. Kernels are picked at
+// compile time: AVX when the compiler targets it, else SSE2 on x86, NEON
+// on AArch64, else plain scalar loops. Results match the one-point-at-a-time
+// catmullRom() in World.cpp up to float rounding. GL-free.
+
+// Clear to force the scalar loops (for comparison); on by default.
+extern bool splineSimdEnabled;
+
+// "avx", "sse2", "neon" or "scalar" - what the batch calls currently run.
+const char* splineSimdIsa();
+
+// Position of one span at count t values.
+void evaluateSpanBatch(const TrackSplineSpan& span, const float* t, size_t count,
+    float* outX, float* outZ);
+
+// |dP/dt| of one span at count t values (arc-length integrand).
+void spanSpeedBatch(const TrackSplineSpan& span, const float* t, size_t count, float* outSpeed);
+
+// Tessellates the closed loop through n control points, stepsPerSpan points
+// per span starting at each control point, into outX/outZ (n * stepsPerSpan
+// entries each). Same points, in the same order, as calling catmullRom() for
+// t = 0, 1/steps, ... on every wrapped span.
+void tessellateCatmullRomLoop(const float* controlX, const float* controlZ, size_t n,
+    int stepsPerSpan, float* outX, float* outZ);
+
+#endif // SPLINEBATCH_H
@@ -0,0 +1,95 @@
+#include "StaticBatch.h"
+#include "Primitives.h"
+#include "World.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// Finds (or adds) the chunk covering (x, z). chunkIndex maps grid cells to
+// batch.chunks, -1 while a cell is empty.
+static StaticChunk& chunkAt(StaticBatch& batch, std::vector<int>& chunkIndex,
+    float originX, float originZ, int cellsX, int cellsZ, float x, float z) {
+    int ix = (int)((x - originX) / batch.chunkSize);
+    int iz = (int)((z - originZ) / batch.chunkSize);
+    ix = std::min(std::max(ix, 0), cellsX - 1);
+    iz = std::min(std::max(iz, 0), cellsZ - 1);
+
+    int& index = chunkIndex[iz * cellsX + ix];
+    if (index < 0) {
+        index = (int)batch.chunks.size();
+        batch.chunks.push_back(StaticChunk());
+        StaticChunk& chunk = batch.chunks.back();
+        chunk.building.useVertexColor = false;
+        for (int lod = 0; lod < TRACK_OBJECT_LOD_LEVELS; lod++) chunk.colored[lod].useVertexColor = true;
+    }
+    return batch.chunks[index];
+}
+
+static void growBounds(SceneryBounds& b, const Mesh& mesh) {
+    for (const MeshVertex& v : mesh.vertices) {
+        b.minX = std::min(b.minX, v.x); b.maxX = std::max(b.maxX, v.x);
+        b.minY = std::min(b.minY, v.y); b.maxY = std::max(b.maxY, v.y);
+        b.minZ = std::min(b.minZ, v.z); b.maxZ = std::max(b.maxZ, v.z);
+    }
+}
+
+void buildStaticBatch(StaticBatch& batch, float chunkSize) {
+    batch.chunkSize = chunkSize;
+    batch.chunks.clear();
+
+    // Chunk grid over the positions of everything that gets merged
+    float minX = FLT_MAX, minZ = FLT_MAX, maxX = -FLT_MAX, maxZ = -FLT_MAX;
+    auto extend = [&](float x, float z) {
+        minX = std::min(minX, x); maxX = std::max(maxX, x);
+        minZ = std::min(minZ, z); maxZ = std::max(maxZ, z);
+    };
+    for (const Building& b : buildings) extend(b.x, b.z);
+    for (const Stand& s : stands) extend(s.x, s.z);
+    for (const TrackObject& o : trackObjects) extend(o.x, o.z);
+    if (minX > maxX) return;
+
+    int cellsX = std::max(1, (int)std::ceil((maxX - minX) / chunkSize));
+    int cellsZ = std::max(1, (int)std::ceil((maxZ - minZ) / chunkSize));
+    std::vector<int> chunkIndex(cellsX * cellsZ, -1);
+
+    for (const Building& b : buildings) {
+        StaticChunk& chunk = chunkAt(batch, chunkIndex, minX, minZ, cellsX, cellsZ, b.x, b.z);
+        float height = b.height - 5.0f; // buildings are drawn 5 units shorter
+        appendBox(chunk.building, MeshTransform().translate(b.x, height / 2.0f, b.z).scale(b.width, height, b.depth));
+    }
+
+    for (const Stand& s : stands) {
+        StaticChunk& chunk = chunkAt(batch, chunkIndex, minX, minZ, cellsX, cellsZ, s.x, s.z);
+        for (int lod = 0; lod < TRACK_OBJECT_LOD_LEVELS; lod++) {
+            // base structure, then the roof overhanging it by 1 each side
+            appendBox(chunk.colored[lod], MeshTransform().translate(s.x, 0.0f, s.z).scale(s.width, s.height, s.depth),
+                0.7f, 0.7f, 0.7f);
+            appendBox(chunk.colored[lod], MeshTransform().translate(s.x, s.height / 2.0f + 0.5f, s.z).scale(s.width + 2, 1.0f, s.depth + 2),
+                0.3f, 0.3f, 0.3f);
+        }
+    }
+
+    Mesh objectMeshes[TRACK_OBJECT_TYPES][TRACK_OBJECT_LOD_LEVELS];
+    for (int type = 0; type < TRACK_OBJECT_TYPES; type++) {
+        for (int lod = 0; lod < TRACK_OBJECT_LOD_LEVELS; lod++) buildTrackObjectMesh(type, lod, objectMeshes[type][lod]);
+    }
+    for (const TrackObject& o : trackObjects) {
+        if (o.type < 0 || o.type >= TRACK_OBJECT_TYPES) continue;
+        StaticChunk& chunk = chunkAt(batch, chunkIndex, minX, minZ, cellsX, cellsZ, o.x, o.z);
+        MeshTransform xf;
+        xf.translate(o.x, 0.0f, o.z);
+        for (int lod = 0; lod < TRACK_OBJECT_LOD_LEVELS; lod++) appendMesh(chunk.colored[lod], objectMeshes[o.type][lod], xf);
+    }
+
+    for (StaticChunk& chunk : batch.chunks) {
+        chunk.bounds = { FLT_MAX, FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        growBounds(chunk.bounds, chunk.building);
+        growBounds(chunk.bounds, chunk.colored[0]);
+    }
+}
+
+float staticChunkDistance(const SceneryBounds& bounds, float x, float z) {
+    float dx = std::max(std::max(bounds.minX - x, x - bounds.maxX), 0.0f);
+    float dz = std::max(std::max(bounds.minZ - z, z - bounds.maxZ), 0.0f);
+    return sqrtf(dx * dx + dz * dz);
+}
@@ -0,0 +1,42 @@
+#ifndef STATICBATCH_H
+#define STATICBATCH_H
+
+#include "Mesh.h"
+#include "Scenery.h"
+#include "SpatialGrid.h"
+#include <vector>
+
+// Static scenery (buildings, stands, tire stacks, barriers, lamp posts and
+// banners) transformed to world space once and merged per material. The
+// ground is split into square chunks so the merged geometry can still be
+// frustum culled: each chunk is one draw per material. GL-free; the
+// renderer uploads every chunk mesh once.
+
+enum StaticMaterial {
+    STATIC_MATERIAL_BUILDING,  // building texture, white
+    STATIC_MATERIAL_COLORED,   // untextured, vertex colors
+    STATIC_MATERIAL_COUNT
+};
+
+struct StaticChunk {
+    SceneryBounds bounds;      // union of everything merged into the chunk
+    Mesh building;             // STATIC_MATERIAL_BUILDING
+    // STATIC_MATERIAL_COLORED, one per track object level (stands are the
+    // same in every level)
+    Mesh colored[TRACK_OBJECT_LOD_LEVELS];
+};
+
+struct StaticBatch {
+    float chunkSize = 128.0f;
+    std::vector<StaticChunk> chunks; // occupied chunks only
+};
+
+// Rebuilds batch from the generated world. Call whenever the world is
+// regenerated.
+void buildStaticBatch(StaticBatch& batch, float chunkSize = 128.0f);
+
+// Horizontal distance from (x, z) to a chunk's bounds; 0 inside. Used to
+// pick a chunk's level, so the chunk the camera stands in stays at level 0.
+float staticChunkDistance(const SceneryBounds& bounds, float x, float z);
+
+#endif // STATICBATCH_H
@@ -0,0 +1,113 @@
+#include "TextureCache.h"
+#include "AtomicFile.h"
+#include <cstdio>
+#include <string>
+
+struct BakedTextureHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t format;      // TextureFormat
+    uint32_t levelCount;
+    uint64_t sourceHash;
+};
+
+struct BakedTextureLevel {
+    uint32_t width, height;
+    uint32_t size;        // bytes of data following the level table
+    uint32_t reserved;
+};
+
+// Largest chain a baked file may claim (a 32768 texel edge)
+static const uint32_t MAX_BAKED_LEVELS = 16;
+
+bool hashTextureSource(const char* path, uint64_t& hash) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+
+    hash = 14695981039346656037ULL;
+    unsigned char buffer[16384];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            hash ^= buffer[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+std::string bakedTexturePath(const char* sourcePath) {
+    return std::string(sourcePath) + ".rtex";
+}
+
+bool loadBakedTexture(const char* path, uint64_t sourceHash, TextureImage& image) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+
+    BakedTextureHeader header;
+    BakedTextureLevel levels[MAX_BAKED_LEVELS];
+    bool ok = fread(&header, sizeof(header), 1, f) == 1 &&
+        header.magic == BAKED_TEXTURE_MAGIC && header.version == BAKED_TEXTURE_VERSION &&
+        header.sourceHash == sourceHash && header.format <= TEXTURE_BC3 &&
+        header.levelCount > 0 && header.levelCount <= MAX_BAKED_LEVELS &&
+        fread(levels, sizeof(BakedTextureLevel), header.levelCount, f) == header.levelCount;
+
+    if (ok) {
+        image.format = (TextureFormat)header.format;
+        image.levels.resize(header.levelCount);
+        for (uint32_t i = 0; ok && i < header.levelCount; i++) {
+            TextureLevel& level = image.levels[i];
+            level.width = (int)levels[i].width;
+            level.height = (int)levels[i].height;
+            ok = levels[i].size == textureLevelSize(image.format, level.width, level.height);
+            if (ok) {
+                level.data.resize(levels[i].size);
+                ok = fread(level.data.data(), 1, level.data.size(), f) == level.data.size();
+            }
+        }
+    }
+    fclose(f);
+    if (!ok) image.levels.clear();
+    return ok;
+}
+
+bool saveBakedTexture(const char* path, uint64_t sourceHash, const TextureImage& image) {
+    if (image.levels.empty() || image.levels.size() > MAX_BAKED_LEVELS) return false;
+
+    // Written under a temporary name, so a reader never sees half a file
+    std::string tmpPath = std::string(path) + ".tmp";
+    FILE* f = fopen(tmpPath.c_str(), "wb");
+    if (!f) {
+        printf("Texture cache: cannot write %s\n", tmpPath.c_str());
+        return false;
+    }
+
+    BakedTextureHeader header;
+    header.magic = BAKED_TEXTURE_MAGIC;
+    header.version = BAKED_TEXTURE_VERSION;
+    header.format = image.format;
+    header.levelCount = (uint32_t)image.levels.size();
+    header.sourceHash = sourceHash;
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+
+    for (const TextureLevel& level : image.levels) {
+        BakedTextureLevel entry;
+        entry.width = (uint32_t)level.width;
+        entry.height = (uint32_t)level.height;
+        entry.size = (uint32_t)level.data.size();
+        entry.reserved = 0;
+        if (ok) ok = fwrite(&entry, sizeof(entry), 1, f) == 1;
+    }
+    for (const TextureLevel& level : image.levels) {
+        if (ok) ok = fwrite(level.data.data(), 1, level.data.size(), f) == level.data.size();
+    }
+    if (fclose(f) != 0) ok = false;
+
+    if (!ok || !replaceFileAtomically(tmpPath.c_str(), path)) {
+        printf("Texture cache: failed to write %s\n", path);
+        remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
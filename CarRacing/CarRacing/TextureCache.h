@@ -0,0 +1,30 @@
+#ifndef TEXTURECACHE_H
+#define TEXTURECACHE_H
+
+#include "TextureImage.h"
+#include <cstdint>
+#include <string>
+
+// Baked textures: a prepared mip chain (RGBA8 or block-compressed) saved
+// next to its source image, keyed by a hash of the source file's bytes, so
+// later launches skip JPEG decoding and mip generation entirely. GL-free.
+//
+// Bump BAKED_TEXTURE_VERSION whenever prepareTextureImage() or the block
+// encoder changes output.
+
+const uint32_t BAKED_TEXTURE_MAGIC = 0x58455452; // "RTEX"
+const uint32_t BAKED_TEXTURE_VERSION = 1;
+
+// FNV-1a 64 of the whole file. False if it cannot be read.
+bool hashTextureSource(const char* path, uint64_t& hash);
+
+// Baked file for a source image ("grass.jpg" -> "grass.jpg.rtex").
+std::string bakedTexturePath(const char* sourcePath);
+
+// Reads a baked image if its version and source hash match. The caller
+// checks image.format against what it can upload.
+bool loadBakedTexture(const char* path, uint64_t sourceHash, TextureImage& image);
+
+bool saveBakedTexture(const char* path, uint64_t sourceHash, const TextureImage& image);
+
+#endif // TEXTURECACHE_H
@@ -0,0 +1,121 @@
+#include "TextureImage.h"
+#include <cstring>
+
+static int nextPowerOfTwo(int v) {
+    int p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+// Bilinear resample of a bottom-up RGBA8 image
+static void resample(const TextureLevel& src, TextureLevel& dst, int width, int height) {
+    dst.width = width;
+    dst.height = height;
+    dst.data.resize((size_t)width * height * 4);
+
+    // Source columns and weights are the same for every row
+    float scaleX = (float)src.width / width;
+    float scaleY = (float)src.height / height;
+    std::vector<int> col0(width), col1(width);
+    std::vector<int> weightX(width);
+    for (int x = 0; x < width; x++) {
+        float sx = (x + 0.5f) * scaleX - 0.5f;
+        if (sx < 0.0f) sx = 0.0f;
+        int x0 = (int)sx;
+        col0[x] = x0 * 4;
+        col1[x] = (x0 + 1 < src.width ? x0 + 1 : x0) * 4;
+        weightX[x] = (int)((sx - x0) * 256.0f);
+    }
+
+    // 8.8 fixed-point weights
+    for (int y = 0; y < height; y++) {
+        float sy = (y + 0.5f) * scaleY - 0.5f;
+        if (sy < 0.0f) sy = 0.0f;
+        int y0 = (int)sy;
+        int y1 = y0 + 1 < src.height ? y0 + 1 : y0;
+        int fy = (int)((sy - y0) * 256.0f);
+        const unsigned char* row0 = &src.data[(size_t)y0 * src.width * 4];
+        const unsigned char* row1 = &src.data[(size_t)y1 * src.width * 4];
+        unsigned char* out = &dst.data[(size_t)y * width * 4];
+        for (int x = 0; x < width; x++) {
+            const unsigned char* p00 = row0 + col0[x];
+            const unsigned char* p10 = row0 + col1[x];
+            const unsigned char* p01 = row1 + col0[x];
+            const unsigned char* p11 = row1 + col1[x];
+            int fx = weightX[x];
+            for (int c = 0; c < 4; c++) {
+                int top = p00[c] * 256 + (p10[c] - p00[c]) * fx;
+                int bottom = p01[c] * 256 + (p11[c] - p01[c]) * fx;
+                out[x * 4 + c] = (unsigned char)((top * 256 + (bottom - top) * fy + 32768) >> 16);
+            }
+        }
+    }
+}
+
+size_t textureLevelSize(TextureFormat format, int width, int height) {
+    size_t blocks = (size_t)((width + 3) / 4) * ((height + 3) / 4);
+    switch (format) {
+    case TEXTURE_BC1: return blocks * 8;
+    case TEXTURE_BC3: return blocks * 16;
+    default: return (size_t)width * height * 4;
+    }
+}
+
+void prepareTextureImage(const unsigned char* rgba, int width, int height, TextureImage& image) {
+    image.format = TEXTURE_RGBA8;
+    image.levels.assign(1, TextureLevel());
+    TextureLevel& base = image.levels[0];
+    base.width = width;
+    base.height = height;
+    base.data.resize((size_t)width * height * 4);
+
+    size_t row = (size_t)width * 4;
+    for (int y = 0; y < height; y++) {
+        memcpy(&base.data[(size_t)y * row], rgba + (size_t)(height - 1 - y) * row, row);
+    }
+
+    int potWidth = nextPowerOfTwo(width), potHeight = nextPowerOfTwo(height);
+    if (potWidth != width || potHeight != height) {
+        TextureLevel scaled;
+        resample(base, scaled, potWidth, potHeight);
+        image.levels[0] = std::move(scaled);
+    }
+
+    buildMipChain(image);
+}
+
+void buildMipChain(TextureImage& image) {
+    image.levels.resize(1);
+    while (image.levels.back().width > 1 || image.levels.back().height > 1) {
+        const TextureLevel& src = image.levels.back();
+        TextureLevel dst;
+        dst.width = src.width > 1 ? src.width / 2 : 1;
+        dst.height = src.height > 1 ? src.height / 2 : 1;
+        dst.data.resize((size_t)dst.width * dst.height * 4);
+
+        // 2x2 box; a dimension already at 1 averages the same texel twice
+        for (int y = 0; y < dst.height; y++) {
+            int y0 = y * 2, y1 = src.height > 1 ? y0 + 1 : y0;
+            for (int x = 0; x < dst.width; x++) {
+                int x0 = x * 2, x1 = src.width > 1 ? x0 + 1 : x0;
+                const unsigned char* p00 = &src.data[((size_t)y0 * src.width + x0) * 4];
+                const unsigned char* p10 = &src.data[((size_t)y0 * src.width + x1) * 4];
+                const unsigned char* p01 = &src.data[((size_t)y1 * src.width + x0) * 4];
+                const unsigned char* p11 = &src.data[((size_t)y1 * src.width + x1) * 4];
+                unsigned char* out = &dst.data[((size_t)y * dst.width + x) * 4];
+                for (int c = 0; c < 4; c++) {
+                    out[c] = (unsigned char)((p00[c] + p10[c] + p01[c] + p11[c] + 2) >> 2);
+                }
+            }
+        }
+        image.levels.push_back(std::move(dst));
+    }
+}
+
+bool textureHasAlpha(const TextureImage& image) {
+    const std::vector<unsigned char>& texels = image.levels[0].data;
+    for (size_t i = 3; i < texels.size(); i += 4) {
+        if (texels[i] != 255) return true;
+    }
+    return false;
+}
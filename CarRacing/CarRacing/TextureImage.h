@@ -0,0 +1,43 @@
+#ifndef TEXTUREIMAGE_H
+#define TEXTUREIMAGE_H
+
+#include <cstddef>
+#include <vector>
+
+// CPU side of texture loading: decoded RGBA8 pixels turned into a full mip
+// chain ready for glTexImage2D (or block-compressed for
+// glCompressedTexImage2D), so workers do everything except the upload.
+// GL-free.
+
+enum TextureFormat {
+    TEXTURE_RGBA8,
+    TEXTURE_BC1,   // DXT1: opaque RGB, 8 bytes per 4x4 block
+    TEXTURE_BC3    // DXT5: RGB + interpolated alpha, 16 bytes per 4x4 block
+};
+
+struct TextureLevel {
+    int width = 0, height = 0;
+    std::vector<unsigned char> data; // RGBA8 rows bottom-up, or 4x4 blocks
+};
+
+struct TextureImage {
+    TextureFormat format = TEXTURE_RGBA8;
+    std::vector<TextureLevel> levels; // 0 is full size, last is 1x1
+};
+
+// Bytes of one level of the given size.
+size_t textureLevelSize(TextureFormat format, int width, int height);
+
+// Flips rows to GL's bottom-left origin (SOIL_FLAG_INVERT_Y), rescales to
+// power-of-two sizes the way SOIL does for mipmapped textures, then builds
+// the mip chain. rgba is top-down, tightly packed.
+void prepareTextureImage(const unsigned char* rgba, int width, int height, TextureImage& image);
+
+// Box-filters levels[0] down to 1x1, replacing any existing smaller levels.
+// RGBA8 only.
+void buildMipChain(TextureImage& image);
+
+// True if any texel of an RGBA8 image is not fully opaque.
+bool textureHasAlpha(const TextureImage& image);
+
+#endif // TEXTUREIMAGE_H
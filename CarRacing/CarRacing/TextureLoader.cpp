@@ -0,0 +1,129 @@
+#include "TextureLoader.h"
+#include "TextureImage.h"
+#include "TextureCache.h"
+#include "BlockCompress.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+struct TextureLoad {
+    GLuint texture;
+    std::string filename;
+    TextureImage image;
+    bool decoded;
+};
+
+static ThreadPool* loaderPool = nullptr;
+static TextureDecodeFunc decodeImage = nullptr;
+static TextureFreeFunc freeImage = nullptr;
+static bool compressTextures = false;
+
+bool textureCacheEnabled = true;
+
+// Finished decodes waiting for the GL thread
+static std::mutex finishedMutex;
+static std::vector<TextureLoad*> finished;
+static int outstanding = 0; // GL thread only
+
+void initTextureLoader(ThreadPool& pool, TextureDecodeFunc decode, TextureFreeFunc release) {
+    loaderPool = &pool;
+    decodeImage = decode;
+    freeImage = release;
+    compressTextures = glHasS3tc;
+}
+
+static void setTextureParameters() {
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+// A baked image is usable if the driver can take its format
+static bool uploadableFormat(TextureFormat format) {
+    return compressTextures ? format != TEXTURE_RGBA8 : format == TEXTURE_RGBA8;
+}
+
+// Worker side: the baked chain if it is current, else decode, flip,
+// power-of-two, mips, compress, and bake for next time
+static void decodeTexture(TextureLoad* load) {
+    const char* filename = load->filename.c_str();
+    uint64_t sourceHash = 0;
+    bool cached = textureCacheEnabled && hashTextureSource(filename, sourceHash);
+    std::string bakedPath = bakedTexturePath(filename);
+
+    if (cached && loadBakedTexture(bakedPath.c_str(), sourceHash, load->image) &&
+        uploadableFormat(load->image.format)) {
+        load->decoded = true;
+    }
+    else {
+        int width = 0, height = 0;
+        unsigned char* pixels = decodeImage(filename, &width, &height);
+        load->decoded = pixels != nullptr;
+        if (pixels) {
+            prepareTextureImage(pixels, width, height, load->image);
+            freeImage(pixels);
+            if (compressTextures) {
+                compressTextureImage(load->image, textureHasAlpha(load->image) ? TEXTURE_BC3 : TEXTURE_BC1);
+            }
+            if (cached) saveBakedTexture(bakedPath.c_str(), sourceHash, load->image);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(finishedMutex);
+    finished.push_back(load);
+}
+
+GLuint loadTextureAsync(const char* filename, unsigned char r, unsigned char g, unsigned char b) {
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    setTextureParameters();
+    const unsigned char placeholder[4] = { r, g, b, 255 };
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    TextureLoad* load = new TextureLoad();
+    load->texture = texture;
+    load->filename = filename;
+    load->decoded = false;
+    outstanding++;
+    submitTask(*loaderPool, [load] { decodeTexture(load); });
+    return texture;
+}
+
+int pumpTextureUploads() {
+    std::vector<TextureLoad*> ready;
+    {
+        std::lock_guard<std::mutex> lock(finishedMutex);
+        ready.swap(finished);
+    }
+
+    for (TextureLoad* load : ready) {
+        if (load->decoded) {
+            glBindTexture(GL_TEXTURE_2D, load->texture);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            const TextureImage& image = load->image;
+            GLenum compressed = image.format == TEXTURE_BC1 ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT :
+                GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            for (size_t i = 0; i < image.levels.size(); i++) {
+                const TextureLevel& level = image.levels[i];
+                if (image.format == TEXTURE_RGBA8) {
+                    glTexImage2D(GL_TEXTURE_2D, (GLint)i, GL_RGBA, level.width, level.height, 0,
+                        GL_RGBA, GL_UNSIGNED_BYTE, level.data.data());
+                }
+                else {
+                    glExtCompressedTexImage2D(GL_TEXTURE_2D, (GLint)i, compressed, level.width, level.height, 0,
+                        (GLsizei)level.data.size(), level.data.data());
+                }
+            }
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+        else {
+            printf("Texture loader: cannot decode '%s', keeping placeholder\n", load->filename.c_str());
+        }
+        delete load;
+        outstanding--;
+    }
+    return outstanding;
+}
@@ -0,0 +1,35 @@
+#ifndef TEXTURELOADER_H
+#define TEXTURELOADER_H
+
+#include "GLExtensions.h"
+#include "ThreadPool.h"
+
+// Loads textures without blocking the first frame. Each request gets its
+// texture name at once, holding a 1x1 placeholder color; a pool worker
+// decodes the file and builds the mip chain, and pumpTextureUploads() on
+// the GL thread swaps the real image in once it is ready.
+//
+// With the texture cache on, the prepared chain is baked next to the source
+// (TextureCache.h), BC1/BC3-compressed when the driver has S3TC, and later
+// launches upload the baked levels directly.
+
+// Decodes a file to top-down, tightly packed RGBA8, or returns nullptr.
+// Called on worker threads, so it must be thread-safe.
+typedef unsigned char* (*TextureDecodeFunc)(const char* path, int* width, int* height);
+typedef void (*TextureFreeFunc)(unsigned char* pixels);
+
+// Bake and reuse .rtex files (on by default).
+extern bool textureCacheEnabled;
+
+// Call once after loadGLExtensions() and before loadTextureAsync(). pool
+// must outlive the loads.
+void initTextureLoader(ThreadPool& pool, TextureDecodeFunc decode, TextureFreeFunc release);
+
+// Repeat wrap, trilinear filtering. The placeholder stays if decoding fails.
+GLuint loadTextureAsync(const char* filename, unsigned char r, unsigned char g, unsigned char b);
+
+// Uploads every image decoded since the last call. GL thread only; call
+// once per frame. Returns the number of textures still loading.
+int pumpTextureUploads();
+
+#endif // TEXTURELOADER_H
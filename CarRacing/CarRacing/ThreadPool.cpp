@@ -0,0 +1,113 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <memory>
+
+ThreadPool::~ThreadPool() {
+    stopThreadPool(*this);
+}
+
+int defaultWorkerCount() {
+    int hardware = (int)std::thread::hardware_concurrency();
+    return hardware > 2 ? hardware - 1 : 1;
+}
+
+static void workerLoop(ThreadPool& pool) {
+    std::unique_lock<std::mutex> lock(pool.mutex);
+    for (;;) {
+        pool.wake.wait(lock, [&] { return pool.stopping || !pool.tasks.empty(); });
+        if (pool.tasks.empty()) return; // stopping and drained
+
+        std::function<void()> task = std::move(pool.tasks.front());
+        pool.tasks.pop_front();
+        pool.busy++;
+        lock.unlock();
+        task();
+        lock.lock();
+        pool.busy--;
+        if (pool.busy == 0 && pool.tasks.empty()) pool.idle.notify_all();
+    }
+}
+
+void startThreadPool(ThreadPool& pool, int threads) {
+    stopThreadPool(pool);
+    pool.stopping = false;
+    for (int i = 0; i < threads; i++) {
+        pool.workers.emplace_back(workerLoop, std::ref(pool));
+    }
+}
+
+void stopThreadPool(ThreadPool& pool) {
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.stopping = true;
+    }
+    pool.wake.notify_all();
+    for (std::thread& t : pool.workers) t.join();
+    pool.workers.clear();
+}
+
+void submitTask(ThreadPool& pool, std::function<void()> task) {
+    if (pool.workers.empty()) {
+        task();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.tasks.push_back(std::move(task));
+    }
+    pool.wake.notify_one();
+}
+
+void waitThreadPool(ThreadPool& pool) {
+    std::unique_lock<std::mutex> lock(pool.mutex);
+    pool.idle.wait(lock, [&] { return pool.busy == 0 && pool.tasks.empty(); });
+}
+
+// Shared with the helper tasks, which may start after parallelFor() has
+// returned and must then find nothing left to claim.
+struct ParallelForState {
+    std::function<void(int, int)> body;
+    int count = 0, grain = 1, chunks = 0;
+    std::atomic<int> next{ 0 };
+    std::atomic<int> done{ 0 };
+    std::mutex mutex;
+    std::condition_variable finished;
+};
+
+static void runParallelChunks(ParallelForState& state) {
+    for (;;) {
+        int chunk = state.next++;
+        if (chunk >= state.chunks) return;
+        int begin = chunk * state.grain;
+        state.body(begin, std::min(begin + state.grain, state.count));
+        if (++state.done == state.chunks) {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.finished.notify_all();
+        }
+    }
+}
+
+void parallelFor(ThreadPool& pool, int count, int grain, const std::function<void(int begin, int end)>& body) {
+    if (count <= 0) return;
+    if (grain < 1) grain = 1;
+    int chunks = (count + grain - 1) / grain;
+    if (pool.workers.empty() || chunks == 1) {
+        body(0, count);
+        return;
+    }
+
+    std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>();
+    state->body = body;
+    state->count = count;
+    state->grain = grain;
+    state->chunks = chunks;
+
+    int helpers = std::min(chunks - 1, (int)pool.workers.size());
+    for (int i = 0; i < helpers; i++) {
+        submitTask(pool, [state] { runParallelChunks(*state); });
+    }
+    runParallelChunks(*state);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&] { return state->done == state->chunks; });
+}
@@ -0,0 +1,49 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads draining one FIFO task queue. Tasks must not
+// touch GL; hand results back to the main thread instead. With zero
+// workers submitted tasks run inline, so callers need no special case.
+
+struct ThreadPool {
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable wake;  // workers: a task arrived or stopping
+    std::condition_variable idle;  // waiters: queue drained
+    int busy = 0;
+    bool stopping = false;
+
+    ~ThreadPool();
+};
+
+// Worker count for the machine: one per hardware thread beyond the main
+// thread, at least one.
+int defaultWorkerCount();
+
+// Starts threads workers (restarting the pool if it was running).
+void startThreadPool(ThreadPool& pool, int threads);
+
+// Finishes queued tasks, then joins the workers.
+void stopThreadPool(ThreadPool& pool);
+
+void submitTask(ThreadPool& pool, std::function<void()> task);
+
+// Blocks until the queue is empty and no task is running.
+void waitThreadPool(ThreadPool& pool);
+
+// Runs body over [0, count) in chunks of grain, on the workers and the
+// calling thread, and returns once every chunk is done. The caller claims
+// chunks too, so it never waits behind unrelated queued tasks for work
+// nobody has started.
+void parallelFor(ThreadPool& pool, int count, int grain, const std::function<void(int begin, int end)>& body);
+
+#endif // THREADPOOL_H
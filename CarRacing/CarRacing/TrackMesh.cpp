@@ -0,0 +1,136 @@
+#include "TrackMesh.h"
+#include "World.h"
+#include <algorithm>
+#include <cmath>
+
+// ==================== TRACK SURFACE ====================
+void buildTrackSurfaceMesh(Mesh& mesh, float texRepeat) {
+    mesh.primitive = MESH_TRIANGLE_STRIP;
+    mesh.vertices.clear();
+    if (innerTrack.empty() || outerTrack.empty()) return;
+
+    int n = (int)innerTrack.size();
+    mesh.vertices.reserve((n + 1) * 2);
+
+    for (int i = 0; i <= n; ++i) {
+        int idx = i % n;
+
+        float s = (i / (float)n) * texRepeat;
+
+        mesh.vertices.push_back(makeVertex(outerTrack[idx].first, 0.01f, outerTrack[idx].second,
+            0.0f, 1.0f, 0.0f, s, 0.0f));
+        mesh.vertices.push_back(makeVertex(innerTrack[idx].first, 0.01f, innerTrack[idx].second,
+            0.0f, 1.0f, 0.0f, s, 1.0f));
+    }
+}
+
+// ==================== KERBS ====================
+// One kerb quad from edge segment (x1,z1)-(x2,z2), pushed out by the
+// perpendicular (px,pz), split into two triangles.
+static void addKerbQuad(Mesh& mesh, float x1, float z1, float x2, float z2,
+    float px, float pz, float kerbWidth, float kerbHeight, bool red) {
+    float kx1 = x1 + px * kerbWidth;
+    float kz1 = z1 + pz * kerbWidth;
+    float kx2 = x2 + px * kerbWidth;
+    float kz2 = z2 + pz * kerbWidth;
+
+    float g = red ? 0.0f : 1.0f;
+    MeshVertex a = makeVertex(x1, kerbHeight, z1, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, g, g);
+    MeshVertex b = makeVertex(x2, kerbHeight, z2, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, g, g);
+    MeshVertex c = makeVertex(kx2, kerbHeight, kz2, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 1.0f, g, g);
+    MeshVertex d = makeVertex(kx1, kerbHeight, kz1, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, g, g);
+
+    mesh.vertices.push_back(a);
+    mesh.vertices.push_back(b);
+    mesh.vertices.push_back(c);
+    mesh.vertices.push_back(a);
+    mesh.vertices.push_back(c);
+    mesh.vertices.push_back(d);
+}
+
+void buildKerbMesh(Mesh& mesh, float kerbWidth, float kerbHeight) {
+    mesh.primitive = MESH_TRIANGLES;
+    mesh.vertices.clear();
+    if (innerTrack.empty() || outerTrack.empty()) return;
+
+    int n = (int)innerTrack.size();
+    mesh.vertices.reserve(n * 12);
+
+    for (int i = 0; i < n; i++) {
+        int j = (i + 1) % n;
+        bool red = (i % 2 == 0);
+
+        // Inner edge, kerb pushed inward
+        {
+            float dx = innerTrack[j].first - innerTrack[i].first;
+            float dz = innerTrack[j].second - innerTrack[i].second;
+            float len = sqrtf(dx * dx + dz * dz);
+            if (len == 0) len = 1;
+            dx /= len;
+            dz /= len;
+
+            addKerbQuad(mesh, innerTrack[i].first, innerTrack[i].second,
+                innerTrack[j].first, innerTrack[j].second,
+                -dz, dx, kerbWidth, kerbHeight, red);
+        }
+
+        // Outer edge, kerb pushed outward
+        {
+            float dx = outerTrack[j].first - outerTrack[i].first;
+            float dz = outerTrack[j].second - outerTrack[i].second;
+            float len = sqrtf(dx * dx + dz * dz);
+            if (len == 0) len = 1;
+            dx /= len;
+            dz /= len;
+
+            addKerbQuad(mesh, outerTrack[i].first, outerTrack[i].second,
+                outerTrack[j].first, outerTrack[j].second,
+                -dz, dx, kerbWidth, kerbHeight, red);
+        }
+    }
+}
+
+// ==================== MIDDLE LINE ====================
+void buildMiddleLineMesh(Mesh& mesh, float dashLength, float gapLength) {
+    mesh.primitive = MESH_LINES;
+    mesh.vertices.clear();
+    if (innerTrack.empty() || outerTrack.empty()) return;
+
+    int n = (int)innerTrack.size();
+
+    for (int i = 0; i < n; i++) {
+        // Current and next middle point
+        int nextIdx = (i + 1) % n;
+        float x0 = (innerTrack[i].first + outerTrack[i].first) * 0.5f;
+        float z0 = (innerTrack[i].second + outerTrack[i].second) * 0.5f;
+        float x1 = (innerTrack[nextIdx].first + outerTrack[nextIdx].first) * 0.5f;
+        float z1 = (innerTrack[nextIdx].second + outerTrack[nextIdx].second) * 0.5f;
+
+        float dx = x1 - x0;
+        float dz = z1 - z0;
+        float segmentLength = sqrtf(dx * dx + dz * dz);
+        if (segmentLength == 0.0f) continue;
+
+        // Direction vector normalized
+        float dirX = dx / segmentLength;
+        float dirZ = dz / segmentLength;
+
+        float traveled = 0.0f;
+        bool drawDash = true;
+
+        while (traveled < segmentLength) {
+            float start = traveled;
+            float end = std::min(traveled + (drawDash ? dashLength : gapLength), segmentLength);
+
+            if (drawDash) {
+                mesh.vertices.push_back(makeVertex(x0 + dirX * start, 0.02f, z0 + dirZ * start,
+                    0.0f, 1.0f, 0.0f, 0.0f, 0.0f));
+                mesh.vertices.push_back(makeVertex(x0 + dirX * end, 0.02f, z0 + dirZ * end,
+                    0.0f, 1.0f, 0.0f, 1.0f, 0.0f));
+            }
+
+            traveled = end;
+            drawDash = !drawDash;
+        }
+    }
+}
@@ -0,0 +1,18 @@
+#ifndef TRACKMESH_H
+#define TRACKMESH_H
+
+#include "Mesh.h"
+
+// Builds the static track geometry from innerTrack/outerTrack. Call after
+// generateTrackPoints(); the results only change when the track does.
+
+// Asphalt ribbon as a triangle strip, texcoords repeat texRepeat times per lap.
+void buildTrackSurfaceMesh(Mesh& mesh, float texRepeat = 40.0f);
+
+// Red/white kerbs along both edges as triangles.
+void buildKerbMesh(Mesh& mesh, float kerbWidth = 2.0f, float kerbHeight = 0.2f);
+
+// Dashed centre line as GL_LINES pairs.
+void buildMiddleLineMesh(Mesh& mesh, float dashLength = 2.0f, float gapLength = 1.0f);
+
+#endif // TRACKMESH_H
@@ -0,0 +1,165 @@
+#include "TrackQuery.h"
+#include "World.h"
+#include <algorithm>
+#include <cmath>
+
+static const int TRACK_BVH_LEAF_SIZE = 8;
+
+static void segmentBounds(const TrackSegment& s, float& minX, float& minZ, float& maxX, float& maxZ) {
+    minX = std::min(s.x0, s.x0 + s.dx); maxX = std::max(s.x0, s.x0 + s.dx);
+    minZ = std::min(s.z0, s.z0 + s.dz); maxZ = std::max(s.z0, s.z0 + s.dz);
+}
+
+// Builds the subtree over order[first, first + count) into nodes[nodeIndex].
+static void buildNode(TrackIndex& index, int nodeIndex, int first, int count) {
+    TrackBvhNode node = { 1e30f, 1e30f, -1e30f, -1e30f, first, count };
+    for (int i = first; i < first + count; i++) {
+        float minX, minZ, maxX, maxZ;
+        segmentBounds(index.segments[index.order[i]], minX, minZ, maxX, maxZ);
+        node.minX = std::min(node.minX, minX); node.maxX = std::max(node.maxX, maxX);
+        node.minZ = std::min(node.minZ, minZ); node.maxZ = std::max(node.maxZ, maxZ);
+    }
+
+    if (count <= TRACK_BVH_LEAF_SIZE) {
+        index.nodes[nodeIndex] = node;
+        return;
+    }
+
+    // Median split of segment midpoints along the longer axis
+    bool splitX = (node.maxX - node.minX) >= (node.maxZ - node.minZ);
+    int half = count / 2;
+    const std::vector<TrackSegment>& segs = index.segments;
+    std::nth_element(index.order.begin() + first, index.order.begin() + first + half,
+        index.order.begin() + first + count, [&](int a, int b) {
+            return splitX ? segs[a].x0 + segs[a].dx * 0.5f < segs[b].x0 + segs[b].dx * 0.5f
+                          : segs[a].z0 + segs[a].dz * 0.5f < segs[b].z0 + segs[b].dz * 0.5f;
+        });
+
+    int left = (int)index.nodes.size();
+    index.nodes.resize(index.nodes.size() + 2);
+    node.first = left;
+    node.count = 0;
+    index.nodes[nodeIndex] = node;
+
+    buildNode(index, left, first, half);
+    buildNode(index, left + 1, first + half, count - half);
+}
+
+void buildTrackIndex(TrackIndex& index) {
+    index.segments.clear();
+    index.order.clear();
+    index.nodes.clear();
+    index.totalLength = 0.0f;
+
+    size_t n = std::min(innerTrack.size(), outerTrack.size());
+    if (n < 2) return;
+
+    index.segments.resize(n);
+    float arc = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        size_t j = (i + 1) % n;
+        float ax = (innerTrack[i].first + outerTrack[i].first) * 0.5f;
+        float az = (innerTrack[i].second + outerTrack[i].second) * 0.5f;
+        float bx = (innerTrack[j].first + outerTrack[j].first) * 0.5f;
+        float bz = (innerTrack[j].second + outerTrack[j].second) * 0.5f;
+        float wx = outerTrack[i].first - innerTrack[i].first;
+        float wz = outerTrack[i].second - innerTrack[i].second;
+
+        TrackSegment& s = index.segments[i];
+        s.x0 = ax; s.z0 = az;
+        s.dx = bx - ax; s.dz = bz - az;
+        float len2 = s.dx * s.dx + s.dz * s.dz;
+        s.invLen2 = len2 > 0.0f ? 1.0f / len2 : 0.0f;
+        s.length = sqrtf(len2);
+        s.startArc = arc;
+        s.halfWidth = sqrtf(wx * wx + wz * wz) * 0.5f;
+        arc += s.length;
+    }
+    index.totalLength = arc;
+
+    index.order.resize(n);
+    for (size_t i = 0; i < n; i++) index.order[i] = (int)i;
+    index.nodes.reserve(2 * n / TRACK_BVH_LEAF_SIZE + 2);
+    index.nodes.resize(1);
+    buildNode(index, 0, 0, (int)n);
+}
+
+static float boxDistance2(const TrackBvhNode& node, float x, float z) {
+    float dx = std::max(std::max(node.minX - x, 0.0f), x - node.maxX);
+    float dz = std::max(std::max(node.minZ - z, 0.0f), z - node.maxZ);
+    return dx * dx + dz * dz;
+}
+
+// Squared distance from (x, z) to the segment, with the clamped parameter.
+static inline float segmentDistance2(const TrackSegment& s, float x, float z, float& t) {
+    t = ((x - s.x0) * s.dx + (z - s.z0) * s.dz) * s.invLen2;
+    t = std::min(std::max(t, 0.0f), 1.0f);
+    float px = s.x0 + s.dx * t - x;
+    float pz = s.z0 + s.dz * t - z;
+    return px * px + pz * pz;
+}
+
+TrackQueryResult queryTrack(const TrackIndex& index, float x, float z) {
+    float bestDist2 = 1e30f;
+    int bestSegment = 0;
+    float bestT = 0.0f;
+
+    // Depth-first, nearer child first; each entry keeps its box distance so
+    // it can be rejected on pop once a closer segment has been found
+    int stack[64];
+    float stackDist2[64];
+    int top = 0;
+    stack[top] = 0;
+    stackDist2[top++] = 0.0f;
+    while (top > 0) {
+        --top;
+        if (stackDist2[top] >= bestDist2) continue;
+        const TrackBvhNode& node = index.nodes[stack[top]];
+
+        if (node.count > 0) {
+            for (int i = node.first; i < node.first + node.count; i++) {
+                int si = index.order[i];
+                float t;
+                float d2 = segmentDistance2(index.segments[si], x, z, t);
+                if (d2 < bestDist2) {
+                    bestDist2 = d2;
+                    bestSegment = si;
+                    bestT = t;
+                }
+            }
+            continue;
+        }
+
+        int near = node.first, far = node.first + 1;
+        float nearDist2 = boxDistance2(index.nodes[near], x, z);
+        float farDist2 = boxDistance2(index.nodes[far], x, z);
+        if (farDist2 < nearDist2) {
+            std::swap(near, far);
+            std::swap(nearDist2, farDist2);
+        }
+        if (farDist2 < bestDist2) {
+            stack[top] = far;
+            stackDist2[top++] = farDist2;
+        }
+        if (nearDist2 < bestDist2) {
+            stack[top] = near;
+            stackDist2[top++] = nearDist2;
+        }
+    }
+
+    const TrackSegment& s = index.segments[bestSegment];
+    TrackQueryResult r;
+    r.segment = bestSegment;
+    r.t = bestT;
+    r.x = s.x0 + s.dx * bestT;
+    r.z = s.z0 + s.dz * bestT;
+    r.distance = sqrtf(bestDist2);
+    r.progress = s.startArc + s.length * bestT;
+
+    // Side from the cross product with the travel direction; outerTrack
+    // lies on the +(-dz, dx) side, as built in generateTrackPoints()
+    float cross = (x - s.x0) * s.dz - (z - s.z0) * s.dx;
+    r.lateral = cross < 0.0f ? r.distance : -r.distance;
+    r.onTrack = r.distance <= s.halfWidth;
+    return r;
+}
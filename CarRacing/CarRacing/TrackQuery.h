@@ -0,0 +1,51 @@
+#ifndef TRACKQUERY_H
+#define TRACKQUERY_H
+
+#include <vector>
+
+// Closest-point queries against the track centerline (the midpoint of
+// innerTrack/outerTrack). The closed centerline is split into segments
+// held in a static bounding-volume hierarchy, so a query visits O(log n)
+// nodes instead of scanning every segment. GL-free; safe to query from
+// several threads once built.
+
+struct TrackSegment {
+    float x0, z0;     // start point
+    float dx, dz;     // end - start
+    float invLen2;    // 1 / |d|^2, 0 for degenerate segments
+    float length;
+    float startArc;   // arc length from centerline point 0 to the start
+    float halfWidth;  // half the track width at the start
+};
+
+struct TrackBvhNode {
+    float minX, minZ, maxX, maxZ;
+    int first;        // leaf: first segment in order; inner: left child (right is first + 1)
+    int count;        // segments in a leaf, 0 for inner nodes
+};
+
+struct TrackIndex {
+    std::vector<TrackSegment> segments;
+    std::vector<int> order;           // segment indices, grouped by leaf
+    std::vector<TrackBvhNode> nodes;  // nodes[0] is the root
+    float totalLength = 0.0f;
+};
+
+struct TrackQueryResult {
+    float x, z;        // closest point on the centerline
+    int segment;       // segment containing it
+    float t;           // position along that segment, 0..1
+    float distance;    // from the query point to the centerline
+    float lateral;     // signed offset: > 0 toward outerTrack, < 0 toward innerTrack
+    float progress;    // arc length from the start of the centerline
+    bool onTrack;      // |lateral| within the half track width
+};
+
+// Builds the index from the generated innerTrack/outerTrack. Call again
+// whenever the track is regenerated.
+void buildTrackIndex(TrackIndex& index);
+
+// Closest centerline point to (x, z). The index must not be empty.
+TrackQueryResult queryTrack(const TrackIndex& index, float x, float z);
+
+#endif // TRACKQUERY_H
@@ -0,0 +1,142 @@
+#include "TrackSpline.h"
+#include "SplineBatch.h"
+#include <cmath>
+
+// Sub-steps per span when integrating arc length for the table
+static const int ARC_SUBSTEPS = 16;
+
+static void spanVelocity(const TrackSplineSpan& s, float t, float& vx, float& vz) {
+    vx = s.bx + t * (2.0f * s.cx + t * 3.0f * s.dx);
+    vz = s.bz + t * (2.0f * s.cz + t * 3.0f * s.dz);
+}
+
+// 3-point Gauss-Legendre rule on [-1, 1]
+static const float GAUSS_NODES[3] = { -0.7745966692f, 0.0f, 0.7745966692f };
+static const float GAUSS_WEIGHTS[3] = { 0.5555555556f, 0.8888888889f, 0.5555555556f };
+
+void buildTrackSpline(TrackSpline& spline, const std::vector<std::pair<float, float>>& controls,
+    float tableStep) {
+    spline.spans.clear();
+    spline.tableU.clear();
+    spline.tableStep = tableStep;
+    spline.totalLength = 0.0f;
+
+    size_t n = controls.size();
+    if (n < 2 || tableStep <= 0.0f) return;
+
+    // Same basis as catmullRom() in World.cpp, wrapped around the loop
+    spline.spans.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        const std::pair<float, float>& p0 = controls[(i + n - 1) % n];
+        const std::pair<float, float>& p1 = controls[i];
+        const std::pair<float, float>& p2 = controls[(i + 1) % n];
+        const std::pair<float, float>& p3 = controls[(i + 2) % n];
+
+        TrackSplineSpan& s = spline.spans[i];
+        s.ax = p1.first;
+        s.bx = 0.5f * (-p0.first + p2.first);
+        s.cx = 0.5f * (2.0f * p0.first - 5.0f * p1.first + 4.0f * p2.first - p3.first);
+        s.dx = 0.5f * (-p0.first + 3.0f * p1.first - 3.0f * p2.first + p3.first);
+        s.az = p1.second;
+        s.bz = 0.5f * (-p0.second + p2.second);
+        s.cz = 0.5f * (2.0f * p0.second - 5.0f * p1.second + 4.0f * p2.second - p3.second);
+        s.dz = 0.5f * (-p0.second + 3.0f * p1.second - 3.0f * p2.second + p3.second);
+    }
+
+    // Cumulative arc length at every sub-step of every span. The quadrature
+    // nodes are the same for every span, so each span's speeds come from one
+    // batch call.
+    float nodeT[ARC_SUBSTEPS * 3];
+    float speed[ARC_SUBSTEPS * 3];
+    float half = 0.5f / ARC_SUBSTEPS;
+    for (int k = 0; k < ARC_SUBSTEPS; k++) {
+        float mid = (k + 0.5f) / ARC_SUBSTEPS;
+        for (int g = 0; g < 3; g++) nodeT[k * 3 + g] = mid + half * GAUSS_NODES[g];
+    }
+
+    std::vector<float> arc(n * ARC_SUBSTEPS + 1);
+    arc[0] = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        spanSpeedBatch(spline.spans[i], nodeT, ARC_SUBSTEPS * 3, speed);
+        for (int k = 0; k < ARC_SUBSTEPS; k++) {
+            const float* v = speed + k * 3;
+            size_t j = i * ARC_SUBSTEPS + k;
+            arc[j + 1] = arc[j] + half * (GAUSS_WEIGHTS[0] * v[0] + GAUSS_WEIGHTS[1] * v[1] + GAUSS_WEIGHTS[2] * v[2]);
+        }
+    }
+    spline.totalLength = arc.back();
+
+    // Invert: parameter at every multiple of tableStep, by walking the
+    // sub-steps and interpolating inside the one that holds the distance
+    // (the last entry lies past the end and continues into span 0 + n, so
+    // lookups just short of a full lap interpolate across the seam)
+    size_t entries = (size_t)(spline.totalLength / tableStep) + 2;
+    spline.tableU.resize(entries);
+    size_t j = 0;
+    for (size_t e = 0; e < entries; e++) {
+        float d = e * tableStep;
+        float lap = 0.0f;
+        if (d >= spline.totalLength) {
+            d -= spline.totalLength;
+            lap = (float)n;
+            j = 0;
+        }
+        while (j + 2 < arc.size() && arc[j + 1] < d) j++;
+        float len = arc[j + 1] - arc[j];
+        float frac = len > 0.0f ? (d - arc[j]) / len : 0.0f;
+        spline.tableU[e] = lap + (j + frac) / (float)ARC_SUBSTEPS;
+    }
+}
+
+float trackSplineParameter(const TrackSpline& spline, float distance) {
+    float length = spline.totalLength;
+    distance = fmodf(distance, length);
+    if (distance < 0.0f) distance += length;
+
+    float pos = distance / spline.tableStep;
+    size_t e = (size_t)pos;
+    float frac = pos - (float)e;
+    return spline.tableU[e] + (spline.tableU[e + 1] - spline.tableU[e]) * frac;
+}
+
+TrackSplinePoint evaluateTrackSpline(const TrackSpline& spline, float distance) {
+    float u = trackSplineParameter(spline, distance);
+    size_t n = spline.spans.size();
+    size_t span = (size_t)u;
+    float t = u - (float)span;
+    if (span >= n) span -= n; // past the seam, back into span 0
+    const TrackSplineSpan& s = spline.spans[span];
+
+    TrackSplinePoint p;
+    p.x = s.ax + t * (s.bx + t * (s.cx + t * s.dx));
+    p.z = s.az + t * (s.bz + t * (s.cz + t * s.dz));
+
+    float vx, vz;
+    spanVelocity(s, t, vx, vz);
+    float ax = 2.0f * s.cx + 6.0f * s.dx * t;
+    float az = 2.0f * s.cz + 6.0f * s.dz * t;
+    float speed2 = vx * vx + vz * vz;
+    float speed = sqrtf(speed2);
+    if (speed > 0.0f) {
+        p.tx = vx / speed;
+        p.tz = vz / speed;
+        p.curvature = (vx * az - vz * ax) / (speed2 * speed);
+    }
+    else {
+        p.tx = 1.0f; p.tz = 0.0f;
+        p.curvature = 0.0f;
+    }
+    return p;
+}
+
+void resampleTrackSpline(const TrackSpline& spline, float spacing, std::vector<TrackSplinePoint>& out) {
+    out.clear();
+    if (spline.spans.empty() || spacing <= 0.0f) return;
+
+    int count = (int)floorf(spline.totalLength / spacing + 0.5f);
+    if (count < 3) count = 3;
+    float step = spline.totalLength / count;
+
+    out.resize(count);
+    for (int i = 0; i < count; i++) out[i] = evaluateTrackSpline(spline, i * step);
+}
@@ -0,0 +1,47 @@
+#ifndef TRACKSPLINE_H
+#define TRACKSPLINE_H
+
+#include <utility>
+#include <vector>
+
+// Closed Catmull-Rom spline through the track's control points,
+// parameterized by arc length. Each span's cubic is stored as polynomial
+// coefficients, and a table of spline parameters at fixed distance steps
+// turns a distance into a span and local t with one lookup, so evaluation
+// at any distance is O(1). GL-free.
+
+struct TrackSplineSpan {
+    // x(t) = ax + bx t + cx t^2 + dx t^3, t in [0, 1]; same for z
+    float ax, bx, cx, dx;
+    float az, bz, cz, dz;
+};
+
+struct TrackSplinePoint {
+    float x, z;
+    float tx, tz;      // unit tangent in the direction of travel
+    float curvature;   // signed, 1 / radius; > 0 turning towards +(-tz, tx)
+};
+
+struct TrackSpline {
+    std::vector<TrackSplineSpan> spans;
+    std::vector<float> tableU;  // spline parameter (span + t) at each multiple of tableStep
+    float tableStep = 0.25f;
+    float totalLength = 0.0f;
+};
+
+// Builds the spline through controls (treated as a closed loop) and its
+// arc-length table. tableStep is the table spacing in world units.
+void buildTrackSpline(TrackSpline& spline, const std::vector<std::pair<float, float>>& controls,
+    float tableStep = 0.25f);
+
+// Spline parameter (span index + local t) at an arc length; distances wrap
+// around the loop.
+float trackSplineParameter(const TrackSpline& spline, float distance);
+
+TrackSplinePoint evaluateTrackSpline(const TrackSpline& spline, float distance);
+
+// Points at exactly even arc-length spacing around the whole loop. The
+// spacing is adjusted so a whole number of steps closes the loop.
+void resampleTrackSpline(const TrackSpline& spline, float spacing, std::vector<TrackSplinePoint>& out);
+
+#endif // TRACKSPLINE_H
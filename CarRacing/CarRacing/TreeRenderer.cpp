@@ -0,0 +1,65 @@
+#include "TreeRenderer.h"
+#include "InstancedMesh.h"
+#include "Scenery.h"
+#include <cmath>
+
+static GpuMesh trunkMesh[TREE_LOD_LEVELS];
+static GpuMesh canopyMesh[TREE_LOD_LEVELS];
+static GpuMesh topMesh[TREE_LOD_LEVELS];
+
+static InstanceBuffer bodyInstances[TREE_LOD_LEVELS];
+static InstanceBuffer topInstances[TREE_LOD_LEVELS];
+
+static std::vector<MeshInstance> treeBodies;
+static std::vector<MeshInstance> treeTops;
+static std::vector<signed char> treeLod; // level each tree was drawn at, -1 before the first frame
+
+void initTreeRenderer() {
+    for (int lod = 0; lod < TREE_LOD_LEVELS; lod++) {
+        Mesh trunk, canopy, top;
+        buildTreeMeshes(lod, trunk, canopy, top);
+        uploadMesh(trunkMesh[lod], trunk);
+        uploadMesh(canopyMesh[lod], canopy);
+        uploadMesh(topMesh[lod], top);
+    }
+}
+
+void uploadTrees(const std::vector<Tree>& trees) {
+    treeBodies.resize(trees.size());
+    treeTops.resize(trees.size());
+    treeLod.assign(trees.size(), -1);
+    for (size_t i = 0; i < trees.size(); i++) {
+        buildTreeInstances(trees[i], treeBodies[i], treeTops[i]);
+    }
+}
+
+void drawTrees(float camX, float camZ, GLuint leafTexture, const std::vector<int>* visible) {
+    static std::vector<MeshInstance> bodies[TREE_LOD_LEVELS];
+    static std::vector<MeshInstance> tops[TREE_LOD_LEVELS];
+    for (int lod = 0; lod < TREE_LOD_LEVELS; lod++) {
+        bodies[lod].clear();
+        tops[lod].clear();
+    }
+
+    size_t count = visible ? visible->size() : treeBodies.size();
+    for (size_t n = 0; n < count; n++) {
+        size_t i = visible ? (size_t)(*visible)[n] : n;
+        float dx = treeBodies[i].x - camX;
+        float dz = treeBodies[i].z - camZ;
+        int lod = selectLod(TREE_LOD, sqrtf(dx * dx + dz * dz), treeLod[i]);
+        treeLod[i] = (signed char)lod;
+
+        bodies[lod].push_back(treeBodies[i]);
+        tops[lod].push_back(treeTops[i]);
+    }
+
+    for (int lod = 0; lod < TREE_LOD_LEVELS; lod++) {
+        if (bodies[lod].empty()) continue;
+        uploadInstances(bodyInstances[lod], bodies[lod], true);
+        uploadInstances(topInstances[lod], tops[lod], true);
+
+        drawMeshInstanced(trunkMesh[lod], bodyInstances[lod]);
+        drawMeshInstanced(canopyMesh[lod], bodyInstances[lod], leafTexture);
+        drawMeshInstanced(topMesh[lod], topInstances[lod], leafTexture);
+    }
+}
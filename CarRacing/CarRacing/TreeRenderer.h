@@ -0,0 +1,24 @@
+#ifndef TREERENDERER_H
+#define TREERENDERER_H
+
+#include "GLExtensions.h"
+#include "World.h"
+#include <vector>
+
+// Trees share one mesh set per level of detail, built once. Each frame the
+// trees are bucketed by camera distance (TREE_LOD, with hysteresis per
+// tree) and every bucket is drawn with instanced calls (trunk, textured
+// canopy, textured top).
+
+// Call once after initInstancedRenderer().
+void initTreeRenderer();
+
+// Call whenever the tree list is regenerated.
+void uploadTrees(const std::vector<Tree>& trees);
+
+// visible, when given, lists the indices of the trees to draw (from the
+// frustum cull); otherwise every tree is drawn.
+void drawTrees(float camX, float camZ, GLuint leafTexture,
+    const std::vector<int>* visible = nullptr);
+
+#endif // TREERENDERER_H
@@ -0,0 +1,179 @@
+#include "Vehicles.h"
+#include "Collision.h"
+#include "World.h"
+#include "TrackQuery.h"
+#include <algorithm>
+#include <cmath>
+
+void resizeVehicles(VehicleSet& set, int count) {
+    CarState defaults;
+    set.count = count;
+    set.x.resize(count, defaults.x);
+    set.z.resize(count, defaults.z);
+    set.angle.resize(count, defaults.angle);
+    set.speed.resize(count, defaults.speed);
+    set.tireRotation.resize(count, defaults.tireRotation);
+    set.throttle.resize(count, 0.0f);
+    set.steer.resize(count, 0.0f);
+    set.offTrack.resize(count, 0);
+    set.colliding.resize(count, 0);
+}
+
+CarState getVehicle(const VehicleSet& set, int i) {
+    CarState car;
+    car.x = set.x[i];
+    car.z = set.z[i];
+    car.angle = set.angle[i];
+    car.speed = set.speed[i];
+    car.tireRotation = set.tireRotation[i];
+    return car;
+}
+
+void setVehicle(VehicleSet& set, int i, const CarState& car) {
+    set.x[i] = car.x;
+    set.z[i] = car.z;
+    set.angle[i] = car.angle;
+    set.speed[i] = car.speed;
+    set.tireRotation[i] = car.tireRotation;
+}
+
+void setVehicleInput(VehicleSet& set, int i, const CarInput& input) {
+    set.throttle[i] = input.forward ? 1.0f : (input.backward ? -1.0f : 0.0f);
+    set.steer[i] = (input.left ? 1.0f : 0.0f) - (input.right ? 1.0f : 0.0f);
+}
+
+void placeVehiclesOnGrid(VehicleSet& set, const TrackIndex& track) {
+    if (set.count == 0) return;
+
+    CarState pole;
+    resetCar(pole);
+    setVehicle(set, 0, pole);
+    if (trackSpline.spans.empty()) return;
+
+    // Centerline progress equals spline distance: both start at sample 0
+    float start = track.segments.empty() ? 0.0f : queryTrack(track, pole.x, pole.z).progress;
+    for (int i = 1; i < set.count; i++) {
+        int row = (i + 1) / 2;
+        float side = (i & 1) ? GRID_LATERAL : -GRID_LATERAL;
+        TrackSplinePoint p = evaluateTrackSpline(trackSpline, start - row * GRID_ROW_SPACING);
+
+        CarState car;
+        car.x = p.x - p.tz * side;
+        car.z = p.z + p.tx * side;
+        car.angle = atan2f(p.tx, p.tz) * 180.0f / M_PI_F;
+        car.speed = 0.0f;
+        car.tireRotation = 0.0f;
+        setVehicle(set, i, car);
+    }
+}
+
+// sin and cos of an angle in degrees within [-270, 270], to float
+// precision. Branch-free, so the update loop still vectorizes where calls
+// to sinf/cosf would not.
+static inline void sinCosDeg(float deg, float& s, float& c) {
+    // Fold into [-90, 90]: sin(180 - a) = sin(a), cos(180 - a) = -cos(a).
+    // Both sides of every select are computed up front; GCC will not
+    // if-convert a select that guards arithmetic.
+    float mirrored = std::copysign(180.0f, deg) - deg;
+    float folded = std::fabs(deg) > 90.0f ? mirrored : deg;
+    float x = folded * (M_PI_F / 180.0f);
+    float x2 = x * x;
+
+    // Taylor series to x^11 and x^12, under 1e-7 off on [-pi/2, pi/2]
+    s = x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f +
+        x2 * (1.0f / 362880.0f + x2 * (-1.0f / 39916800.0f))))));
+    float cosine = 1.0f + x2 * (-0.5f + x2 * (1.0f / 24.0f + x2 * (-1.0f / 720.0f +
+        x2 * (1.0f / 40320.0f + x2 * (-1.0f / 3628800.0f + x2 * (1.0f / 479001600.0f))))));
+    c = std::fabs(deg) > 90.0f ? -cosine : cosine;
+}
+
+// The arrays are passed as restrict parameters: GCC only trusts restrict
+// there, and without it the loop needs more run-time alias checks than it
+// is willing to emit.
+static void updateVehicleArrays(int n, float deltaTime,
+    float* __restrict x, float* __restrict z, float* __restrict angle,
+    float* __restrict speed, float* __restrict tireRotation,
+    const float* __restrict throttle, const float* __restrict steer) {
+    const float accel = ACCELERATION * deltaTime;
+    const float friction = FRICTION * deltaTime;
+    const float turn = TURN_ANGLE * deltaTime;
+    const float degreesPerUnit = 360.0f / (2.0f * M_PI_F * WHEEL_RADIUS);
+
+    for (int i = 0; i < n; i++) {
+        // --- Speed: throttle, or friction towards zero when coasting ---
+        float s = speed[i];
+        float driven = std::min(std::max(s + throttle[i] * accel, -MAX_SPEED_BW), MAX_SPEED_FW);
+        float coasting = std::copysign(std::max(std::fabs(s) - friction, 0.0f), s);
+        s = throttle[i] != 0.0f ? driven : coasting;
+        speed[i] = s;
+
+        // --- Rotation ---
+        float a = angle[i] + steer[i] * turn;
+        a -= a > 180.0f ? 360.0f : 0.0f;
+        a += a < -180.0f ? 360.0f : 0.0f;
+        angle[i] = a;
+
+        // --- Position ---
+        float sn, cs;
+        sinCosDeg(a, sn, cs);
+        float distance = s * deltaTime;
+        x[i] += distance * sn;
+        z[i] += distance * cs;
+
+        // --- Tire rotation ---
+        float r = tireRotation[i] + distance * degreesPerUnit;
+        r -= r > 360.0f ? 360.0f : 0.0f;
+        r += r < -360.0f ? 360.0f : 0.0f;
+        tireRotation[i] = r;
+    }
+}
+
+void updateVehicles(VehicleSet& set, float deltaTime) {
+    updateVehicleArrays(set.count, deltaTime, set.x.data(), set.z.data(), set.angle.data(),
+        set.speed.data(), set.tireRotation.data(), set.throttle.data(), set.steer.data());
+}
+
+void applyVehicleOffTrackDrag(VehicleSet& set, const TrackIndex& track, float deltaTime) {
+    const int n = set.count;
+    for (int i = 0; i < n; i++) {
+        set.offTrack[i] = queryTrack(track, set.x[i], set.z[i]).onTrack ? 0 : 1;
+    }
+
+    const float drop = OFF_TRACK_DRAG * deltaTime;
+    float* speed = set.speed.data();
+    const unsigned char* offTrack = set.offTrack.data();
+    for (int i = 0; i < n; i++) {
+        float s = speed[i];
+        float slowed = std::copysign(std::max(std::fabs(s) - drop, OFF_TRACK_MAX_SPEED), s);
+        speed[i] = (offTrack[i] && std::fabs(s) > OFF_TRACK_MAX_SPEED) ? slowed : s;
+    }
+}
+
+int stepVehiclesFixed(FixedStepClock& clock, VehicleSet& prev, VehicleSet& set,
+    float frameTime, const TrackIndex* track, const CollisionWorld* collision,
+    VehicleControlFunc control, void* controlData) {
+    float dt = fixedStepDt(clock);
+    if (frameTime < 0.0f) frameTime = 0.0f;
+    clock.accumulator += frameTime;
+
+    int steps = 0;
+    while (clock.accumulator >= dt && steps < clock.maxSubsteps) {
+        prev = set;
+        if (control) control(set, controlData);
+        updateVehicles(set, dt);
+        if (track && !track->segments.empty()) applyVehicleOffTrackDrag(set, *track, dt);
+        if (collision) collideVehicles(*collision, prev, set);
+        clock.accumulator -= dt;
+        steps++;
+    }
+
+    // Over budget: drop the backlog rather than paying for it next frame.
+    if (steps == clock.maxSubsteps && clock.accumulator >= dt) {
+        clock.accumulator = 0.0f;
+    }
+    return steps;
+}
+
+CarState interpolateVehicle(const VehicleSet& prev, const VehicleSet& set, int i, float alpha) {
+    return interpolateCar(getVehicle(prev, i), getVehicle(set, i), alpha);
+}
@@ -0,0 +1,68 @@
+#ifndef VEHICLES_H
+#define VEHICLES_H
+
+#include "Simulation.h"
+#include <vector>
+
+struct CollisionWorld;
+
+// Many cars stored as structure-of-arrays, stepped by one batched kernel
+// with the same acceleration/friction/steering/wheel logic as updateCar().
+// Every per-car field is its own contiguous array and the update loop has
+// no data-dependent branches, so the compiler vectorizes it. GL-free.
+
+// ===== Grid =====
+const float GRID_ROW_SPACING = 8.0f;  // along the track between rows
+const float GRID_LATERAL = 3.0f;      // each side of the centerline
+
+struct VehicleSet {
+    int count = 0;
+
+    // State
+    std::vector<float> x, z;
+    std::vector<float> angle;          // degrees, 0 = facing +Z, kept in [-180, 180]
+    std::vector<float> speed;
+    std::vector<float> tireRotation;   // degrees
+
+    // Input
+    std::vector<float> throttle;       // +1 forward, -1 backward, 0 coasting
+    std::vector<float> steer;          // +1 left, -1 right
+
+    std::vector<unsigned char> offTrack;  // set by the last fixed step with a track
+    std::vector<unsigned char> colliding; // set by the last fixed step with collisions
+};
+
+// Resizes every array; new cars start at CarState defaults with no input.
+void resizeVehicles(VehicleSet& set, int count);
+
+CarState getVehicle(const VehicleSet& set, int i);
+void setVehicle(VehicleSet& set, int i, const CarState& car);
+
+// Forward wins over backward, as in updateCar(); left and right cancel.
+void setVehicleInput(VehicleSet& set, int i, const CarInput& input);
+
+// Car 0 goes where resetCar() puts the player; the rest line up two abreast
+// behind it along trackSpline, GRID_ROW_SPACING apart. track locates the
+// start line on the spline.
+void placeVehiclesOnGrid(VehicleSet& set, const TrackIndex& track);
+
+// One step of updateCar() for every car.
+void updateVehicles(VehicleSet& set, float deltaTime);
+
+// applyOffTrackDrag() for every car, recording set.offTrack.
+void applyVehicleOffTrackDrag(VehicleSet& set, const TrackIndex& track, float deltaTime);
+
+// Sets the cars' inputs before each fixed step, e.g. the AI drivers.
+typedef void (*VehicleControlFunc)(VehicleSet& set, void* data);
+
+// stepCarFixed() for the whole set. prev receives the states before the
+// last step taken. control, if given, runs before every step; collision,
+// if given, stops the cars at the scenery they ran into after it.
+int stepVehiclesFixed(FixedStepClock& clock, VehicleSet& prev, VehicleSet& set,
+    float frameTime, const TrackIndex* track = nullptr, const CollisionWorld* collision = nullptr,
+    VehicleControlFunc control = nullptr, void* controlData = nullptr);
+
+// interpolateCar() for car i.
+CarState interpolateVehicle(const VehicleSet& prev, const VehicleSet& set, int i, float alpha);
+
+#endif // VEHICLES_H
@@ -0,0 +1,494 @@
+#include "World.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <cmath>
+
+std::vector<std::pair<float, float>> innerTrack;
+std::vector<std::pair<float, float>> outerTrack;
+TrackSpline trackSpline;
+std::pair<float, float> startLineCenter;
+float startLineAngle = 0.0f;
+
+std::vector<Stand> stands;
+std::vector<Person> audience;
+std::vector<Building> buildings;
+std::vector<Tree> trees;
+std::vector<TrackObject> trackObjects;
+
+static uint32_t worldSeed = DEFAULT_WORLD_SEED;
+
+std::pair<float, float> catmullRom(
+    const std::pair<float, float>& p0,
+    const std::pair<float, float>& p1,
+    const std::pair<float, float>& p2,
+    const std::pair<float, float>& p3,
+    float t
+) {
+    float t2 = t * t;
+    float t3 = t2 * t;
+
+    float x = 0.5f * ((2.0f * p1.first) +
+        (-p0.first + p2.first) * t +
+        (2.0f * p0.first - 5.0f * p1.first + 4.0f * p2.first - p3.first) * t2 +
+        (-p0.first + 3.0f * p1.first - 3.0f * p2.first + p3.first) * t3);
+
+    float z = 0.5f * ((2.0f * p1.second) +
+        (-p0.second + p2.second) * t +
+        (2.0f * p0.second - 5.0f * p1.second + 4.0f * p2.second - p3.second) * t2 +
+        (-p0.second + 3.0f * p1.second - 3.0f * p2.second + p3.second) * t3);
+
+    return { x, z };
+}
+
+// ==================== WORLD SEED ====================
+void setWorldSeed(uint32_t seed) {
+    worldSeed = seed;
+}
+
+uint32_t getWorldSeed() {
+    return worldSeed;
+}
+
+WorldRng worldRng(WorldStream stream) {
+    // Spread the seed so nearby seeds do not give correlated worlds
+    uint64_t x = worldSeed;
+    WorldRng rng;
+    rng.seed(splitMix64(x), (uint64_t)stream);
+    return rng;
+}
+
+//// Call after generating the track
+void generateAudience(int numPeople) {
+    WorldRng rng = worldRng(WORLD_STREAM_AUDIENCE);
+    audience.clear();
+    int trackSize = innerTrack.size();
+
+    for (int i = 0; i < numPeople; i++) {
+        int idx = rngInt(rng, trackSize);
+
+        float offset = TRACK_WIDTH * 1.5f + rngFloat(rng, 0, 10);
+        float side = rngSign(rng);
+
+        size_t nextIdx = (idx + 1) % trackSize;
+        float dx = outerTrack[nextIdx].first - outerTrack[idx].first;
+        float dz = outerTrack[nextIdx].second - outerTrack[idx].second;
+        float len = sqrtf(dx * dx + dz * dz);
+        dx /= len; dz /= len;
+        float px = -dz;
+        float pz = dx;
+
+        Person p;
+        p.x = outerTrack[idx].first + side * px * offset;
+        p.z = outerTrack[idx].second + side * pz * offset;
+        p.baseY = 0.0f;
+        p.jumpPhase = rngFloat(rng, 0.0f, 3.14f * 2.0f);
+        p.jumpSpeed = rngFloat(rng, 0.15f, 0.25f);  // faster jump speed
+
+        p.r = rngFloat(rng, 0.0f, 1.0f);
+        p.g = rngFloat(rng, 0.0f, 1.0f);
+        p.b = rngFloat(rng, 0.0f, 1.0f);
+
+        audience.push_back(p);
+    }
+}
+
+
+
+void generateStands(int numStands) {
+    WorldRng rng = worldRng(WORLD_STREAM_STANDS);
+    stands.clear();
+    int trackSize = innerTrack.size();
+    for (int i = 0; i < numStands; i++) {
+        int idx = rngInt(rng, trackSize);
+
+        // pick midpoint between inner and outer track
+        float midX = (innerTrack[idx].first + outerTrack[idx].first) * 0.5f;
+        float midZ = (innerTrack[idx].second + outerTrack[idx].second) * 0.5f;
+
+        // place stand offset outward
+        float dx = outerTrack[idx].first - innerTrack[idx].first;
+        float dz = outerTrack[idx].second - innerTrack[idx].second;
+        float len = sqrtf(dx * dx + dz * dz);
+        dx /= len; dz /= len;
+
+        float side = rngSign(rng);
+        float offset = TRACK_WIDTH * 3.0f + rngFloat(rng, 0, 30.0f);
+
+        Stand s;
+        s.x = midX + side * dx * offset;
+        s.z = midZ + side * dz * offset;
+        s.width = 15.0f + rngFloat(rng, 0, 10.0f);
+        s.depth = 10.0f + rngFloat(rng, 0, 10.0f);
+        s.height = 6.0f;
+        stands.push_back(s);
+    }
+}
+
+
+
+
+void generateBuildings(int numBuildings,
+    float trackMinX, float trackMaxX,
+    float trackMinZ, float trackMaxZ,
+    float border) {
+    WorldRng rng = worldRng(WORLD_STREAM_BUILDINGS);
+    buildings.clear();
+    for (int i = 0; i < numBuildings; i++) {
+        Building b;
+
+        // Randomly decide which side to place the building
+        int side = rngInt(rng, 4); // 0=left, 1=right, 2=front, 3=back
+
+        switch (side) {
+        case 0: // left
+            b.x = trackMinX - border - rngFloat(rng, 0.0f, border);
+            b.z = trackMinZ - border + rngFloat(rng, 0.0f, trackMaxZ - trackMinZ + 2 * border);
+            break;
+        case 1: // right
+            b.x = trackMaxX + border + rngFloat(rng, 0.0f, border);
+            b.z = trackMinZ - border + rngFloat(rng, 0.0f, trackMaxZ - trackMinZ + 2 * border);
+            break;
+        case 2: // front
+            b.z = trackMinZ - border - rngFloat(rng, 0.0f, border);
+            b.x = trackMinX - border + rngFloat(rng, 0.0f, trackMaxX - trackMinX + 2 * border);
+            break;
+        case 3: // back
+            b.z = trackMaxZ + border + rngFloat(rng, 0.0f, border);
+            b.x = trackMinX - border + rngFloat(rng, 0.0f, trackMaxX - trackMinX + 2 * border);
+            break;
+        }
+
+        // Random building dimensions
+        b.width = 2.0f + rngFloat(rng, 0.0f, 3.0f);
+        b.depth = 2.0f + rngFloat(rng, 0.0f, 3.0f);
+        b.height = 10.0f + rngFloat(rng, 0.0f, 40.0f);
+
+        buildings.push_back(b);
+    }
+}
+
+void generateAllAudience() {
+    audience.clear();
+    generateStands(5);
+    generateAudience();         // random trackside spectators
+}
+
+void generateAudienceInStands() {
+    WorldRng rng = worldRng(WORLD_STREAM_STAND_AUDIENCE);
+    for (const auto& s : stands) {
+        int numPeople = 20 + rngInt(rng, 40);
+        for (int i = 0; i < numPeople; i++) {
+            Person p;
+            p.x = s.x + rngFloat(rng, -s.width / 2, s.width / 2);
+            p.z = s.z + rngFloat(rng, -s.depth / 2, s.depth / 2);
+            p.baseY = 1.0f; // elevate audience above ground
+            p.jumpPhase = rngFloat(rng, 0, 6.28f);
+            p.jumpSpeed = rngFloat(rng, 0.15f, 0.25f);
+            p.r = rngFloat(rng, 0.0f, 1.0f);
+            p.g = rngFloat(rng, 0.0f, 1.0f);
+            p.b = rngFloat(rng, 0.0f, 1.0f);
+            audience.push_back(p);
+        }
+    }
+}
+
+void generateTrees(int numTrees) {
+    WorldRng rng = worldRng(WORLD_STREAM_TREES);
+    trees.clear();
+    for (int i = 0; i < numTrees; i++) {
+        int idx = rngInt(rng, (int)innerTrack.size());
+        float dx = outerTrack[idx].first - innerTrack[idx].first;
+        float dz = outerTrack[idx].second - innerTrack[idx].second;
+        float len = sqrtf(dx * dx + dz * dz);
+        dx /= len; dz /= len;
+
+        float offset = TRACK_WIDTH * 4.0f + rngFloat(rng, 10, 60);
+        float side = rngSign(rng);
+
+        Tree t;
+        t.x = (innerTrack[idx].first + outerTrack[idx].first) * 0.5f + side * dx * offset;
+        t.z = (innerTrack[idx].second + outerTrack[idx].second) * 0.5f + side * dz * offset;
+        t.height = rngFloat(rng, 8.0f, 16.0f);
+        t.radius = rngFloat(rng, 0.5f, 1.2f);
+        trees.push_back(t);
+    }
+}
+
+void generateTrackObjects(int numObjects) {
+    WorldRng rng = worldRng(WORLD_STREAM_TRACK_OBJECTS);
+    trackObjects.clear();
+    for (int i = 0; i < numObjects; i++) {
+        int idx = rngInt(rng, (int)innerTrack.size());
+
+        // Direction vector along track segment
+        float dx = outerTrack[(idx + 1) % innerTrack.size()].first - outerTrack[idx].first;
+        float dz = outerTrack[(idx + 1) % outerTrack.size()].second - outerTrack[idx].second;
+        float len = sqrtf(dx * dx + dz * dz);
+        dx /= len; dz /= len;
+
+        // Perpendicular vector to the track segment
+        float perpX = -dz;
+        float perpZ = dx;
+
+        // Random side (+/-) and offset distance
+        float side = rngSign(rng);  // left or right
+        float minOffset = TRACK_WIDTH * 1.2f;          // avoid middle of track
+        float maxOffset = TRACK_WIDTH * 4.0f;
+        float offset = minOffset + rngFloat(rng, 0.0f, maxOffset - minOffset);
+
+        TrackObject o;
+        o.x = outerTrack[idx].first + perpX * offset * side;
+        o.z = outerTrack[idx].second + perpZ * offset * side;
+        o.type = rngInt(rng, 4); // pick random object type
+        trackObjects.push_back(o);
+    }
+}
+
+// Appends the shortest turn-straight-turn path from the end of centerline,
+// heading (radians), back to the origin heading along +x, turning at
+// radius. The four turn directions are tried and the shortest path wins.
+static void closeTrackLoop(std::vector<std::pair<float, float>>& centerline, float heading, float radius) {
+    const float twoPi = 2.0f * M_PI_F;
+    float x0 = centerline.back().first, z0 = centerline.back().second;
+
+    float bestLength = INFINITY, bestTurn0 = 0.0f, bestStraight = 0.0f;
+    int bestSide0 = 1, bestSide1 = 1;
+    for (int side0 = -1; side0 <= 1; side0 += 2) {
+        for (int side1 = -1; side1 <= 1; side1 += 2) {
+            // Turning circle centers; side +1 turns the way angle grows
+            float cx0 = x0 - side0 * radius * sinf(heading), cz0 = z0 + side0 * radius * cosf(heading);
+            float cx1 = 0.0f, cz1 = side1 * radius;
+            float dx = cx1 - cx0, dz = cz1 - cz0;
+            float d = sqrtf(dx * dx + dz * dz);
+            float straight, along;
+            if (side0 == side1) {
+                straight = d;
+                along = atan2f(dz, dx);
+            }
+            else {
+                if (d < 2.0f * radius) continue; // circles overlap: no crossing tangent
+                straight = sqrtf(d * d - 4.0f * radius * radius);
+                along = atan2f(dz, dx) + atan2f(2.0f * side0 * radius, straight);
+            }
+            float turn0 = fmodf(side0 * (along - heading), twoPi);
+            if (turn0 < 0.0f) turn0 += twoPi;
+            float turn1 = fmodf(side1 * -along, twoPi);
+            if (turn1 < 0.0f) turn1 += twoPi;
+            float length = radius * (turn0 + turn1) + straight;
+            if (length < bestLength) {
+                bestLength = length;
+                bestSide0 = side0; bestSide1 = side1;
+                bestTurn0 = turn0;
+                bestStraight = straight;
+            }
+        }
+    }
+
+    // Walk it with the spacing growing steadily from the last curve's to
+    // the 5 m of the first straight: the uniform Catmull-Rom kinks where
+    // neighbouring spans differ a lot in length
+    size_t last = centerline.size() - 1;
+    float lastX = centerline[last].first - centerline[last - 1].first;
+    float lastZ = centerline[last].second - centerline[last - 1].second;
+    float spacing0 = std::max(0.5f, sqrtf(lastX * lastX + lastZ * lastZ)), spacing1 = 5.0f;
+    int steps = std::max(1, (int)roundf(bestLength * 2.0f / (spacing0 + spacing1)));
+    float arc0 = radius * bestTurn0, arc1Start = arc0 + bestStraight;
+    float sx = x0 - bestSide0 * radius * sinf(heading), sz = z0 + bestSide0 * radius * cosf(heading);
+    float along = heading + bestSide0 * bestTurn0;
+    float lx = sx + bestSide0 * radius * sinf(along), lz = sz - bestSide0 * radius * cosf(along);
+    for (int i = 1; i < steps; i++) {
+        float t = i / (float)steps;
+        float d = bestLength * (spacing0 * t + (spacing1 - spacing0) * t * t * 0.5f) / ((spacing0 + spacing1) * 0.5f);
+        float x, z;
+        if (d < arc0) {
+            float h = heading + bestSide0 * d / radius;
+            x = sx + bestSide0 * radius * sinf(h);
+            z = sz - bestSide0 * radius * cosf(h);
+        }
+        else if (d < arc1Start) {
+            x = lx + cosf(along) * (d - arc0);
+            z = lz + sinf(along) * (d - arc0);
+        }
+        else {
+            // The last turn runs backwards from the origin
+            float back = (bestLength - d) / radius;
+            float h = -bestSide1 * back;
+            x = bestSide1 * radius * sinf(h);
+            z = bestSide1 * radius - bestSide1 * radius * cosf(h);
+        }
+        centerline.push_back({ x, z });
+    }
+    // The origin itself, where the first straight starts
+    centerline.push_back({ 0.0f, 0.0f });
+}
+
+void generateTrackPoints() {
+    WorldRng rng = worldRng(WORLD_STREAM_TRACK);
+    innerTrack.clear();
+    outerTrack.clear();
+    std::vector<std::pair<float, float>> centerline;
+
+    const int numSegments = 10;
+    const float minStraight = 30.0f;
+    const float maxStraight = 80.0f;
+    const float minCurveRadius = 30.0f;
+    const float maxCurveRadius = 80.0f;
+
+    float angle = 0.0f;
+    float x = 0.0f, z = 0.0f;
+
+    // --- Generate rough track path ---
+    for (int s = 0; s < numSegments; s++) {
+        // Straight
+        float straightLen = minStraight + rngFloat(rng, 0.0f, maxStraight - minStraight);
+        float dx = cosf(angle * M_PI_F / 180.0f);
+        float dz = sinf(angle * M_PI_F / 180.0f);
+
+        int stepsStraight = (int)(straightLen / 5.0f);
+        for (int i = 0; i < stepsStraight; i++) {
+            x += dx * 5.0f;
+            z += dz * 5.0f;
+            centerline.push_back({ x, z });
+        }
+
+        // Curve
+        int turnDir = (int)rngSign(rng);
+        float turnAngle = 45.0f + rngFloat(rng, 0.0f, 75.0f); // 45–120°
+        float curveRadius = minCurveRadius + rngFloat(rng, 0.0f, maxCurveRadius - minCurveRadius);
+        int stepsCurve = 20;
+
+        float arcStep = (M_PI_F * curveRadius * (turnAngle / 360.0f)) / stepsCurve;
+
+        for (int i = 0; i < stepsCurve; i++) {
+            angle += turnDir * (turnAngle / stepsCurve);
+            dx = cosf(angle * M_PI_F / 180.0f);
+            dz = sinf(angle * M_PI_F / 180.0f);
+            x += dx * arcStep;
+            z += dz * arcStep;
+            centerline.push_back({ x, z });
+        }
+    }
+
+    // --- Close loop smoothly without duplicating the first point ---
+    // The path ends anywhere, facing anywhere, so a straight line back can
+    // meet it at any angle (and the start at a hairpin). Drive back
+    // instead: turn, straight, turn at the tightest curve radius, ending at
+    // the origin facing along the first straight.
+    closeTrackLoop(centerline, angle * M_PI_F / 180.0f, minCurveRadius);
+
+    // --- Smooth with Catmull-Rom, parameterized by arc length ---
+    buildTrackSpline(trackSpline, centerline);
+
+    // --- Resample evenly for physics/AI ---
+    std::vector<TrackSplinePoint> resampled;
+    float stepSize = 2.0f; // spacing between samples
+    resampleTrackSpline(trackSpline, stepSize, resampled);
+
+    // --- Build inner/outer edges ---
+    for (const TrackSplinePoint& c : resampled) {
+        float px = -c.tz;
+        float pz = c.tx;
+
+        innerTrack.push_back({ c.x - px * (TRACK_WIDTH * 0.5f), c.z - pz * (TRACK_WIDTH * 0.5f) });
+        outerTrack.push_back({ c.x + px * (TRACK_WIDTH * 0.5f), c.z + pz * (TRACK_WIDTH * 0.5f) });
+    }
+
+    // --- Choose a clean start/finish line a bit into the track ---
+    int spawnIndex = 10; // skip first few to avoid overlap
+    startLineCenter = { resampled[spawnIndex].x, resampled[spawnIndex].z };
+    startLineAngle = atan2f(resampled[spawnIndex].tz, resampled[spawnIndex].tx) * 180.0f / M_PI_F; // degrees for OpenGL// <-- store for car spawn
+    float rotationOffset = 90.0f; // degrees
+    startLineAngle += rotationOffset;
+}
+
+void placeTreesAndObjects(int numItems, bool isTree) {
+    WorldRng rng = worldRng(isTree ? WORLD_STREAM_TREE_PLACEMENT : WORLD_STREAM_TRACK_OBJECTS);
+    if (isTree) trees.clear();
+    else trackObjects.clear();
+
+    int totalSegments = outerTrack.size();
+
+    for (int i = 0; i < numItems; i++) {
+        int idx = rngInt(rng, totalSegments);
+        size_t nextIdx = (idx + 1) % totalSegments;
+
+        // Compute direction of track segment
+        float dx = outerTrack[nextIdx].first - outerTrack[idx].first;
+        float dz = outerTrack[nextIdx].second - outerTrack[idx].second;
+        float len = sqrtf(dx * dx + dz * dz);
+        if (len == 0) continue; // skip zero-length segments
+        dx /= len; dz /= len;
+
+        // Perpendicular vector
+        float px = -dz;
+        float pz = dx;
+
+        // Skip sharp curves: compute angle between consecutive segments
+        size_t prevIdx = (idx + totalSegments - 1) % totalSegments;
+        float pdx = outerTrack[idx].first - outerTrack[prevIdx].first;
+        float pdz = outerTrack[idx].second - outerTrack[prevIdx].second;
+        float plen = sqrtf(pdx * pdx + pdz * pdz);
+        if (plen == 0) plen = 1;
+        pdx /= plen; pdz /= plen;
+
+        float dot = dx * pdx + dz * pdz; // cosine of angle
+        if (dot < 0.5f) { // skip very sharp curves
+            i--;
+            continue;
+        }
+
+        // Random side
+        float side = rngSign(rng);
+
+        // Offset: start just outside track + some random variation
+        float minOffset = TRACK_WIDTH * 1.0f;
+        float maxOffset = TRACK_WIDTH * 4.0f;
+        float offset = minOffset + rngFloat(rng, 0.0f, maxOffset - minOffset);
+        
+        float xPos = outerTrack[idx].first + px * offset * side;
+        float zPos = outerTrack[idx].second + pz * offset * side;
+
+        if (isTree) {
+            Tree t;
+            t.x = xPos;
+            t.z = zPos;
+            t.height = rngFloat(rng, 8.0f, 15.0f);  // keep original heights
+            t.radius = rngFloat(rng, 0.5f, 1.0f);   // slimmer trees
+            trees.push_back(t);
+        }
+        else {
+            TrackObject o;
+            o.x = xPos;
+            o.z = zPos;
+            o.type = rngInt(rng, 4);
+            trackObjects.push_back(o);
+        }
+    }
+}
+
+void generateWorld() {
+    generateTrackPoints();
+    generateAllAudience();
+    generateTrees(80);
+
+
+    placeTreesAndObjects(80, true);   // generate 80 trees
+    placeTreesAndObjects(40, false);   // about 40 random objects
+    float trackMinX = 1e6f, trackMaxX = -1e6f;
+    float trackMinZ = 1e6f, trackMaxZ = -1e6f;
+
+    for (auto& p : innerTrack) {
+        if (p.first < trackMinX) trackMinX = p.first;
+        if (p.first > trackMaxX) trackMaxX = p.first;
+        if (p.second < trackMinZ) trackMinZ = p.second;
+        if (p.second > trackMaxZ) trackMaxZ = p.second;
+    }
+
+    for (auto& p : outerTrack) {
+        if (p.first < trackMinX) trackMinX = p.first;
+        if (p.first > trackMaxX) trackMaxX = p.first;
+        if (p.second < trackMinZ) trackMinZ = p.second;
+        if (p.second > trackMaxZ) trackMaxZ = p.second;
+    }
+    generateBuildings(50, trackMinX, trackMaxX, trackMinZ, trackMaxZ, 10.0f);
+}
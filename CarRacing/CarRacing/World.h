@@ -0,0 +1,109 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "Random.h"
+#include "TrackSpline.h"
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+// GL-free track and scenery generation. The generated data lives in the
+// globals below and is read by the renderer in main.cpp.
+
+#define NUM_AUDIENCE 200
+
+struct Person {
+    float x, z;
+    float baseY;      // ground level
+    float jumpPhase;
+    float jumpSpeed;  // speed of jumping
+
+    float r, g, b;    // clothing color
+    // phase for sine jump
+};
+
+struct Stand {
+    float x, z;     // position of the stand
+    float width;
+    float depth;
+    float height;
+};
+
+struct Building {
+    float x, z;       // position
+    float width, depth, height;
+};
+
+struct Tree {
+    float x, z;
+    float height;
+    float radius;
+};
+
+struct TrackObject {
+    float x, z;
+    int type; // 0 = tire stack, 1 = barrier, 2 = lamp post, 3 = banner, etc.
+};
+
+// ===== Generated World =====
+extern std::vector<std::pair<float, float>> innerTrack;
+extern std::vector<std::pair<float, float>> outerTrack;
+extern TrackSpline trackSpline;                 // smoothed centerline, by arc length
+extern std::pair<float, float> startLineCenter; // set in generateTrackPoints()
+extern float startLineAngle;
+
+extern std::vector<Stand> stands;
+extern std::vector<Person> audience;
+extern std::vector<Building> buildings;
+extern std::vector<Tree> trees;
+extern std::vector<TrackObject> trackObjects;
+
+// ===== World Seed =====
+// Each generator draws from its own stream derived from the world seed, so
+// a seed always produces the same world (on every platform) and the
+// generators share no RNG state.
+const uint32_t DEFAULT_WORLD_SEED = 1;
+
+enum WorldStream {
+    WORLD_STREAM_TRACK,
+    WORLD_STREAM_AUDIENCE,
+    WORLD_STREAM_STANDS,
+    WORLD_STREAM_STAND_AUDIENCE,
+    WORLD_STREAM_BUILDINGS,
+    WORLD_STREAM_TREES,
+    WORLD_STREAM_TREE_PLACEMENT,
+    WORLD_STREAM_TRACK_OBJECTS
+};
+
+void setWorldSeed(uint32_t seed);
+uint32_t getWorldSeed();
+
+// Fresh generator for one subsystem of the current world seed.
+WorldRng worldRng(WorldStream stream);
+
+std::pair<float, float> catmullRom(
+    const std::pair<float, float>& p0,
+    const std::pair<float, float>& p1,
+    const std::pair<float, float>& p2,
+    const std::pair<float, float>& p3,
+    float t
+);
+
+void generateTrackPoints();
+void generateAudience(int numPeople = NUM_AUDIENCE);
+void generateStands(int numStands);
+void generateBuildings(int numBuildings,
+    float trackMinX, float trackMaxX,
+    float trackMinZ, float trackMaxZ,
+    float border = 20.0f);
+void generateAllAudience();
+void generateAudienceInStands();
+void generateTrees(int numTrees);
+void generateTrackObjects(int numObjects);
+void placeTreesAndObjects(int numItems, bool isTree);
+
+// Runs the full generation sequence used at startup: track, audience,
+// trees, track objects and buildings around the track bounds.
+void generateWorld();
+
+#endif // WORLD_H
@@ -0,0 +1,264 @@
+#include "WorldCache.h"
+#include "AtomicFile.h"
+#include "World.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Element size of each section, in WorldCacheSection order
+static const uint32_t SECTION_STRIDE[WORLD_SECTION_COUNT] = {
+    sizeof(TrackSplineSpan),
+    sizeof(float),
+    sizeof(float) * 2,
+    sizeof(float) * 2,
+    sizeof(Stand),
+    sizeof(Person),
+    sizeof(Building),
+    sizeof(Tree),
+    sizeof(TrackObject),
+};
+
+static const uint32_t SECTION_ALIGN = 16;
+
+static uint32_t alignUp(uint32_t v) {
+    return (v + SECTION_ALIGN - 1) & ~(SECTION_ALIGN - 1);
+}
+
+// ===== Mapping =====
+static bool mapFile(const char* path, MappedWorld& world) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    world.file = file;
+    world.mapping = mapping;
+    world.data = (const unsigned char*)data;
+    world.size = (size_t)size.QuadPart;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // the mapping keeps the file alive
+    if (data == MAP_FAILED) return false;
+    world.data = (const unsigned char*)data;
+    world.size = (size_t)st.st_size;
+#endif
+    return true;
+}
+
+void unmapWorldCache(MappedWorld& world) {
+    if (world.data) {
+#ifdef _WIN32
+        UnmapViewOfFile(world.data);
+        CloseHandle((HANDLE)world.mapping);
+        CloseHandle((HANDLE)world.file);
+#else
+        munmap((void*)world.data, world.size);
+#endif
+    }
+    world = MappedWorld();
+}
+
+bool mapWorldCache(const char* path, MappedWorld& world) {
+    world = MappedWorld();
+    if (!mapFile(path, world)) return false;
+
+    const char* problem = nullptr;
+    size_t tableEnd = sizeof(WorldCacheHeader) + sizeof(WorldCacheSectionEntry) * WORLD_SECTION_COUNT;
+    const WorldCacheHeader* header = (const WorldCacheHeader*)world.data;
+    if (world.size < tableEnd) problem = "truncated header";
+    else if (header->magic != WORLD_CACHE_MAGIC) problem = "not a world file";
+    else if (header->version != WORLD_CACHE_VERSION) problem = "old version";
+    else if (header->sectionCount != WORLD_SECTION_COUNT) problem = "unexpected section count";
+    else if (header->fileSize != world.size) problem = "truncated file";
+
+    const WorldCacheSectionEntry* sections =
+        (const WorldCacheSectionEntry*)(world.data + sizeof(WorldCacheHeader));
+    for (int i = 0; !problem && i < WORLD_SECTION_COUNT; i++) {
+        const WorldCacheSectionEntry& s = sections[i];
+        if (s.stride != SECTION_STRIDE[i]) problem = "struct layout changed";
+        else if (s.offset % SECTION_ALIGN != 0 || s.offset < tableEnd) problem = "bad section offset";
+        else if (s.offset + (uint64_t)s.count * s.stride > world.size) problem = "section out of bounds";
+    }
+
+    // Sections that are each in bounds can still disagree with one
+    // another; the spline and edge loops index across them unchecked
+    if (!problem) {
+        const WorldCacheSectionEntry& spans = sections[WORLD_SECTION_SPLINE_SPANS];
+        const WorldCacheSectionEntry& table = sections[WORLD_SECTION_SPLINE_TABLE];
+        float length = header->splineLength, step = header->splineTableStep;
+        if (spans.count < 2) problem = "too few spline spans";
+        else if (!(step > 0.0f) || !(length > 0.0f) || !std::isfinite(length) || !std::isfinite(step)) {
+            problem = "bad spline length or table step";
+        }
+        else if (table.count != (uint64_t)(length / step) + 2) problem = "spline table size mismatch";
+        else {
+            const float* u = (const float*)(world.data + table.offset);
+            for (uint32_t i = 0; !problem && i < table.count; i++) {
+                if (!(u[i] >= 0.0f && u[i] < 2.0f * spans.count)) problem = "spline table out of range";
+            }
+        }
+    }
+    if (!problem && sections[WORLD_SECTION_INNER_TRACK].count != sections[WORLD_SECTION_OUTER_TRACK].count) {
+        problem = "track edge counts differ";
+    }
+
+    if (problem) {
+        printf("World cache %s: %s\n", path, problem);
+        unmapWorldCache(world);
+        return false;
+    }
+    world.header = header;
+    world.sections = sections;
+    return true;
+}
+
+const void* worldCacheSection(const MappedWorld& world, WorldCacheSection section, size_t& count) {
+    const WorldCacheSectionEntry& s = world.sections[section];
+    count = s.count;
+    return world.data + s.offset;
+}
+
+// ===== Saving =====
+bool saveWorldCache(const char* path, uint32_t audienceSize) {
+    const void* data[WORLD_SECTION_COUNT] = {
+        trackSpline.spans.data(),
+        trackSpline.tableU.data(),
+        innerTrack.data(),
+        outerTrack.data(),
+        stands.data(),
+        audience.data(),
+        buildings.data(),
+        trees.data(),
+        trackObjects.data(),
+    };
+    const size_t counts[WORLD_SECTION_COUNT] = {
+        trackSpline.spans.size(),
+        trackSpline.tableU.size(),
+        innerTrack.size(),
+        outerTrack.size(),
+        stands.size(),
+        audience.size(),
+        buildings.size(),
+        trees.size(),
+        trackObjects.size(),
+    };
+
+    WorldCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = WORLD_CACHE_MAGIC;
+    header.version = WORLD_CACHE_VERSION;
+    header.seed = getWorldSeed();
+    header.audienceSize = audienceSize;
+    header.sectionCount = WORLD_SECTION_COUNT;
+    header.startX = startLineCenter.first;
+    header.startZ = startLineCenter.second;
+    header.startAngle = startLineAngle;
+    header.splineLength = trackSpline.totalLength;
+    header.splineTableStep = trackSpline.tableStep;
+
+    WorldCacheSectionEntry sections[WORLD_SECTION_COUNT];
+    memset(sections, 0, sizeof(sections));
+    uint32_t offset = alignUp(sizeof(header) + sizeof(sections));
+    for (int i = 0; i < WORLD_SECTION_COUNT; i++) {
+        sections[i].offset = offset;
+        sections[i].count = (uint32_t)counts[i];
+        sections[i].stride = SECTION_STRIDE[i];
+        offset = alignUp(offset + sections[i].count * sections[i].stride);
+    }
+    header.fileSize = offset;
+
+    std::string tmpPath = std::string(path) + ".tmp";
+    FILE* f = fopen(tmpPath.c_str(), "wb");
+    if (!f) {
+        printf("World cache: cannot write %s\n", tmpPath.c_str());
+        return false;
+    }
+
+    static const unsigned char padding[SECTION_ALIGN] = {};
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+        fwrite(sections, sizeof(sections), 1, f) == 1;
+    size_t written = sizeof(header) + sizeof(sections);
+    for (int i = 0; ok && i < WORLD_SECTION_COUNT; i++) {
+        ok = fwrite(padding, 1, sections[i].offset - written, f) == sections[i].offset - written;
+        size_t bytes = (size_t)sections[i].count * sections[i].stride;
+        if (ok && bytes > 0) ok = fwrite(data[i], 1, bytes, f) == bytes;
+        written = sections[i].offset + bytes;
+    }
+    if (ok) ok = fwrite(padding, 1, header.fileSize - written, f) == header.fileSize - written;
+    if (fclose(f) != 0) ok = false;
+
+    if (!ok || !replaceFileAtomically(tmpPath.c_str(), path)) {
+        printf("World cache: failed to write %s\n", path);
+        remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ===== Loading =====
+template <typename T>
+static void copySection(const MappedWorld& world, WorldCacheSection section, std::vector<T>& out) {
+    size_t count;
+    const T* first = (const T*)worldCacheSection(world, section, count);
+    out.assign(first, first + count);
+}
+
+bool loadWorldCache(const char* path, uint32_t seed, uint32_t audienceSize) {
+    MappedWorld world;
+    if (!mapWorldCache(path, world)) return false;
+    if (world.header->seed != seed || world.header->audienceSize != audienceSize) {
+        unmapWorldCache(world);
+        return false;
+    }
+
+    copySection(world, WORLD_SECTION_SPLINE_SPANS, trackSpline.spans);
+    copySection(world, WORLD_SECTION_SPLINE_TABLE, trackSpline.tableU);
+    trackSpline.totalLength = world.header->splineLength;
+    trackSpline.tableStep = world.header->splineTableStep;
+
+    copySection(world, WORLD_SECTION_INNER_TRACK, innerTrack);
+    copySection(world, WORLD_SECTION_OUTER_TRACK, outerTrack);
+    startLineCenter = { world.header->startX, world.header->startZ };
+    startLineAngle = world.header->startAngle;
+
+    copySection(world, WORLD_SECTION_STANDS, stands);
+    copySection(world, WORLD_SECTION_AUDIENCE, audience);
+    copySection(world, WORLD_SECTION_BUILDINGS, buildings);
+    copySection(world, WORLD_SECTION_TREES, trees);
+    copySection(world, WORLD_SECTION_TRACK_OBJECTS, trackObjects);
+
+    unmapWorldCache(world);
+    return true;
+}
@@ -0,0 +1,82 @@
+#ifndef WORLDCACHE_H
+#define WORLDCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Versioned binary snapshot of the generated world (track spline and edges,
+// start line, stands, audience, buildings, trees, track objects). The file
+// is the in-memory layout of each array behind a fixed header and section
+// table, so loading is one mmap plus validation - no parsing. GL-free.
+//
+// Little-endian only; bump WORLD_CACHE_VERSION whenever a generator or one
+// of the stored structs changes, so stale files are regenerated.
+
+const uint32_t WORLD_CACHE_MAGIC = 0x444C5752; // "RWLD"
+const uint32_t WORLD_CACHE_VERSION = 2;
+
+enum WorldCacheSection {
+    WORLD_SECTION_SPLINE_SPANS,  // TrackSplineSpan
+    WORLD_SECTION_SPLINE_TABLE,  // float
+    WORLD_SECTION_INNER_TRACK,   // float x, z
+    WORLD_SECTION_OUTER_TRACK,   // float x, z
+    WORLD_SECTION_STANDS,        // Stand
+    WORLD_SECTION_AUDIENCE,      // Person
+    WORLD_SECTION_BUILDINGS,     // Building
+    WORLD_SECTION_TREES,         // Tree
+    WORLD_SECTION_TRACK_OBJECTS, // TrackObject
+    WORLD_SECTION_COUNT
+};
+
+struct WorldCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t seed;          // world seed the file was generated from
+    uint32_t audienceSize;  // trackside spectators requested at generation
+    uint32_t sectionCount;
+    uint32_t fileSize;
+    float startX, startZ;   // startLineCenter
+    float startAngle;       // startLineAngle
+    float splineLength;     // trackSpline.totalLength
+    float splineTableStep;  // trackSpline.tableStep
+    uint32_t reserved;
+};
+
+struct WorldCacheSectionEntry {
+    uint32_t offset;  // from the start of the file, 16-byte aligned
+    uint32_t count;   // elements
+    uint32_t stride;  // bytes per element; must match the struct size
+    uint32_t reserved;
+};
+
+// A validated, read-only mapping of a world file. Section data points
+// straight into the mapping, so several processes (e.g. servers) mapping
+// the same file share one copy of the pages.
+struct MappedWorld {
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+    const WorldCacheHeader* header = nullptr;
+    const WorldCacheSectionEntry* sections = nullptr;
+    void* file = nullptr;     // platform handles, owned by the mapping
+    void* mapping = nullptr;
+};
+
+// Maps and validates path (magic, version, section bounds and strides, and
+// that the spline table and edge sections agree with each other). Returns
+// false if the file is missing, which is silent (nothing cached yet), or
+// unusable, which prints why.
+bool mapWorldCache(const char* path, MappedWorld& world);
+void unmapWorldCache(MappedWorld& world);
+
+// Start of a section's elements inside a mapped world.
+const void* worldCacheSection(const MappedWorld& world, WorldCacheSection section, size_t& count);
+
+// Writes the current world globals to path (via a temporary file, so
+// readers never see a half-written world).
+bool saveWorldCache(const char* path, uint32_t audienceSize);
+
+// Fills the world globals from path if it holds a world for this seed and
+// audience size; returns false (globals untouched) otherwise.
+bool loadWorldCache(const char* path, uint32_t seed, uint32_t audienceSize);
+
+#endif // WORLDCACHE_H
@@ -1,12 +1,40 @@
 ﻿
+#ifdef _WIN32
 #define NOMINMAX
 #include <windows.h>
+#endif
 #include <GL/glut.h>
 #include <GL/glu.h>
 #include <cmath>
 #include <vector>
 #include <utility>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
 #include <SOIL2.h>
+#include "Simulation.h"
+#include "World.h"
+#include "GpuMesh.h"
+#include "TrackMesh.h"
+#include "InstancedMesh.h"
+#include "Primitives.h"
+#include "Scenery.h"
+#include "CrowdRenderer.h"
+#include "TreeRenderer.h"
+#include "SpatialGrid.h"
+#include "CarMesh.h"
+#include "GpuProfiler.h"
+#include "TrackQuery.h"
+#include "WorldCache.h"
+#include "ThreadPool.h"
+#include "TextureLoader.h"
+#include "RenderQueue.h"
+#include "StaticBatch.h"
+#include "Vehicles.h"
+#include "AiDriver.h"
+#include "Collision.h"
+#include "SimThread.h"
 
 GLuint asphaltTex;
 GLuint tireTexture=0;
@@ -15,403 +43,115 @@ GLuint carTex;
 GLuint helmetTex;
 GLuint treeTexture;
 GLuint buildingTexture;
-// ===== Track Parameters =====
-const float TRACK_WIDTH = 12.0f;   // constant track width
 
+// ===== Workers =====
+ThreadPool workerPool;
 // ===== Car State =====
-float carX = 50.0f, carZ = 50.0f;
-float carAngle = 0.0f;
-float carSpeed = 10.0f;
-float tireRotation = 0.0f; // in degrees
-
-float startLineAngle = 0.0f;
+// Car 0 is the player; the rest of the grid (--cars N) lines up behind it
+// and is AI driven. The cars live on the simulation thread; display()
+// draws the snapshots it publishes.
+int carCount = 1;
+SimThread sim;
 
 
 float camYawOffset = 0.0f;   // Left/right look
 float camPitchOffset = 0.0f; // Up/down look
 
-std::pair<float, float> startLineCenter; // already set in generateTrackPoints()
+int audienceSize = NUM_AUDIENCE; // --audience N
+const char* profileTracePath = nullptr; // --profile FILE
+const char* worldCachePath = nullptr; // --world FILE
+
 float startLineWidth =2.0;      // width of track
 float startLineLength = 4.0;
-// ===== Movement Flags =====
-bool moveForward = false;
-bool moveBackward = false;
-bool moveLeft = false;
-bool moveRight = false;
-
-// ===== Constants =====
-const float MAX_SPEED_FW = 30.0f;
-const float MAX_SPEED_BW = 30.0f;
-const float ACCELERATION = 20.0f;
-const float TURN_ANGLE = 90.0f;
-const float FRICTION = 8.0f;
-const float M_PI_F = 3.14159265358979323846f;
-
-
-
-std::vector<std::pair<float, float>> innerTrack;
-std::vector<std::pair<float, float>> outerTrack;
-
-std::pair<float, float> catmullRom(
-    const std::pair<float, float>& p0,
-    const std::pair<float, float>& p1,
-    const std::pair<float, float>& p2,
-    const std::pair<float, float>& p3,
-    float t
-) {
-    float t2 = t * t;
-    float t3 = t2 * t;
-
-    float x = 0.5f * ((2.0f * p1.first) +
-        (-p0.first + p2.first) * t +
-        (2.0f * p0.first - 5.0f * p1.first + 4.0f * p2.first - p3.first) * t2 +
-        (-p0.first + 3.0f * p1.first - 3.0f * p2.first + p3.first) * t3);
-
-    float z = 0.5f * ((2.0f * p1.second) +
-        (-p0.second + p2.second) * t +
-        (2.0f * p0.second - 5.0f * p1.second + 4.0f * p2.second - p3.second) * t2 +
-        (-p0.second + 3.0f * p1.second - 3.0f * p2.second + p3.second) * t3);
-
-    return { x, z };
-}
-// ===== Timing =====
-int lastTime = 0;
-
-// ===== Display Lists =====
-GLuint trackList = 0;
-GLuint tireList = 0;
-
-#define NUM_AUDIENCE 200
-
-struct Person {
-    float x, z;
-    float baseY;      // ground level
-    float jumpPhase;
-    float jumpSpeed;  // speed of jumping
-
-    float r, g, b;    // clothing color
-    // phase for sine jump
-};
-
-struct Stand {
-    float x, z;     // position of the stand
-    float width;
-    float depth;
-    float height;
-};
-std::vector<Stand> stands;
-
-std::vector<Person> audience;
-struct Building {
-    float x, z;       // position
-    float width, depth, height;
-};
-std::vector<Building> buildings;
-
-
-struct Tree {
-    float x, z;
-    float height;
-    float radius;
-};
 
-struct TrackObject {
-    float x, z;
-    int type; // 0 = tire stack, 1 = barrier, 2 = lamp post, 3 = banner, etc.
+// ===== Track Meshes =====
+GpuMesh trackSurfaceMesh;
+GpuMesh kerbMesh;
+GpuMesh middleLineMesh;
+
+// ===== Scenery Meshes =====
+GpuMesh groundMesh;
+
+// ===== Static Batches =====
+// Buildings, stands and track objects merged per chunk (StaticBatch.h)
+struct StaticChunkMeshes {
+    SceneryBounds bounds;
+    GpuMesh building;
+    GpuMesh colored[TRACK_OBJECT_LOD_LEVELS];
+    int lod = -1;                // level drawn last frame
 };
-std::vector<Tree> trees;
-std::vector<TrackObject> trackObjects;
-
-
-
-// Simple function to generate random float in [a,b]
-float randf(float a, float b) {
-    return a + ((float)rand() / RAND_MAX) * (b - a);
-}
-
-//// Call after generating the track
-void generateAudience() {
-    audience.clear();
-    int trackSize = innerTrack.size();
-
-    for (int i = 0; i < NUM_AUDIENCE; i++) {
-        int idx = rand() % trackSize;
-
-        float offset = TRACK_WIDTH * 1.5f + randf(0, 10);
-        float side = (rand() % 2 == 0 ? 1 : -1);
-
-        size_t nextIdx = (idx + 1) % trackSize;
-        float dx = outerTrack[nextIdx].first - outerTrack[idx].first;
-        float dz = outerTrack[nextIdx].second - outerTrack[idx].second;
-        float len = sqrtf(dx * dx + dz * dz);
-        dx /= len; dz /= len;
-        float px = -dz;
-        float pz = dx;
-
-        Person p;
-        p.x = outerTrack[idx].first + side * px * offset;
-        p.z = outerTrack[idx].second + side * pz * offset;
-        p.baseY = 0.0f;
-        p.jumpPhase = randf(0.0f, 3.14f * 2.0f);
-        p.jumpSpeed = randf(0.15f, 0.25f);  // faster jump speed
-
-        p.r = randf(0.0f, 1.0f);
-        p.g = randf(0.0f, 1.0f);
-        p.b = randf(0.0f, 1.0f);
-
-        audience.push_back(p);
-    }
-}
-
-
-
-void generateStands(int numStands) {
-    stands.clear();
-    int trackSize = innerTrack.size();
-    for (int i = 0; i < numStands; i++) {
-        int idx = rand() % trackSize;
-
-        // pick midpoint between inner and outer track
-        float midX = (innerTrack[idx].first + outerTrack[idx].first) * 0.5f;
-        float midZ = (innerTrack[idx].second + outerTrack[idx].second) * 0.5f;
-
-        // place stand offset outward
-        float dx = outerTrack[idx].first - innerTrack[idx].first;
-        float dz = outerTrack[idx].second - innerTrack[idx].second;
-        float len = sqrtf(dx * dx + dz * dz);
-        dx /= len; dz /= len;
-
-        float side = (rand() % 2 == 0 ? 1.0f : -1.0f);
-        float offset = TRACK_WIDTH * 3.0f + randf(0, 30.0f);
-
-        Stand s;
-        s.x = midX + side * dx * offset;
-        s.z = midZ + side * dz * offset;
-        s.width = 15.0f + randf(0, 10.0f);
-        s.depth = 10.0f + randf(0, 10.0f);
-        s.height = 6.0f;
-        stands.push_back(s);
-    }
-}
-
+std::vector<StaticChunkMeshes> staticChunks;
 
+// ===== Draw Submission =====
+RenderQueue renderQueue;         // filled and flushed every frame
 
+// ===== Tire Barriers =====
+GpuMesh barrierTireMesh;      // one open cylinder, shared by every tire
+InstanceBuffer barrierTires;  // per-tire transforms along both edges
 
-void generateBuildings(int numBuildings,
-    float trackMinX, float trackMaxX,
-    float trackMinZ, float trackMaxZ,
-    float border = 20.0f) {
-    buildings.clear();
-    for (int i = 0; i < numBuildings; i++) {
-        Building b;
-
-        // Randomly decide which side to place the building
-        int side = rand() % 4; // 0=left, 1=right, 2=front, 3=back
-
-        switch (side) {
-        case 0: // left
-            b.x = trackMinX - border - static_cast<float>(rand()) / RAND_MAX * border;
-            b.z = trackMinZ - border + static_cast<float>(rand()) / RAND_MAX * (trackMaxZ - trackMinZ + 2 * border);
-            break;
-        case 1: // right
-            b.x = trackMaxX + border + static_cast<float>(rand()) / RAND_MAX * border;
-            b.z = trackMinZ - border + static_cast<float>(rand()) / RAND_MAX * (trackMaxZ - trackMinZ + 2 * border);
-            break;
-        case 2: // front
-            b.z = trackMinZ - border - static_cast<float>(rand()) / RAND_MAX * border;
-            b.x = trackMinX - border + static_cast<float>(rand()) / RAND_MAX * (trackMaxX - trackMinX + 2 * border);
-            break;
-        case 3: // back
-            b.z = trackMaxZ + border + static_cast<float>(rand()) / RAND_MAX * border;
-            b.x = trackMinX - border + static_cast<float>(rand()) / RAND_MAX * (trackMaxX - trackMinX + 2 * border);
-            break;
-        }
+// ===== Track Queries =====
+TrackIndex trackIndex;           // centerline BVH for on/off-track checks
 
-        // Random building dimensions
-        b.width = 2.0f + static_cast<float>(rand()) / RAND_MAX * 3.0f;
-        b.depth = 2.0f + static_cast<float>(rand()) / RAND_MAX * 3.0f;
-        b.height = 10.0f + static_cast<float>(rand()) / RAND_MAX * 40.0f;
+// ===== Collision =====
+CollisionWorld collisionWorld;   // scenery the cars bump into
 
-        buildings.push_back(b);
-    }
-}
+// ===== AI Opponents =====
+RacingLine racingLine;           // built once per track
+AiDrivers aiDrivers;             // each AI car's place on the line
 
+// ===== Culling =====
+SpatialGrid sceneryGrid;         // static scenery, built after generation
+VisibleScenery visibleScenery;   // refilled every frame from the view frustum
 
+// ===== Level of Detail =====
+GpuMesh wheelTreadMesh[CAR_LOD_LEVELS];
+GpuMesh wheelBodyMesh[CAR_LOD_LEVELS];
+GpuMesh helmetMesh[CAR_LOD_LEVELS];
+GpuMesh carPaintMesh[CAR_LOD_LEVELS];
+GpuMesh carTrimMesh[CAR_LOD_LEVELS];
+std::vector<signed char> carLods; // per car, -1 until first drawn
 
 
-GLuint loadTexture(const char* filename) {
-    GLuint texID = SOIL_load_OGL_texture(
-        filename,
-        SOIL_LOAD_AUTO,
-        SOIL_CREATE_NEW_ID,
-        SOIL_FLAG_MIPMAPS | SOIL_FLAG_INVERT_Y
-    );
-
-    if (texID == 0) {
-        printf("SOIL loading error for '%s': %s\n", filename, SOIL_last_result());
-        return 0;
-    }
 
-    // Bind and configure texture parameters
-    glBindTexture(GL_TEXTURE_2D, texID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    return texID;
+// Texture decoding for the async loader; runs on worker threads. SOIL's
+// image decode keeps no shared state apart from the last-error string.
+unsigned char* decodeSoilImage(const char* filename, int* width, int* height) {
+    int channels = 0;
+    unsigned char* pixels = SOIL_load_image(filename, width, height, &channels, SOIL_LOAD_RGBA);
+    if (!pixels) printf("SOIL loading error for '%s': %s\n", filename, SOIL_last_result());
+    return pixels;
 }
-void generateAllAudience() {
-    audience.clear();
-    generateStands(5);
-    generateAudience();         // random trackside spectators
-}
-void drawPerson(const Person& p, float time) {
-    float jump = sinf(time + p.jumpPhase) * 0.5f; // jump animation
-
-    glPushMatrix();
-    glTranslatef(p.x, p.baseY + jump, p.z);
-
-    // Body
-    glColor3f(p.r, p.g, p.b);
-    glPushMatrix();
-    glScalef(0.5f, 1.5f, 0.3f);
-    glutSolidCube(1.0f);
-    glPopMatrix();
-
-    // Head
-    glPushMatrix();
-    glTranslatef(0.0f, 1.2f, 0.0f);
-    glutSolidSphere(0.4f, 16, 16);
-    glPopMatrix();
-
-    // Arms
-    glPushMatrix();
-    glTranslatef(-0.5f, 0.6f, 0.0f);
-    glScalef(0.2f, 1.0f, 0.2f);
-    glutSolidCube(1.0f);
-    glPopMatrix();
-
-    glPushMatrix();
-    glTranslatef(0.5f, 0.6f, 0.0f);
-    glScalef(0.2f, 1.0f, 0.2f);
-    glutSolidCube(1.0f);
-    glPopMatrix();
-
-    // Legs
-    glPushMatrix();
-    glTranslatef(-0.2f, -1.0f, 0.0f);
-    glScalef(0.25f, 1.2f, 0.25f);
-    glutSolidCube(1.0f);
-    glPopMatrix();
-
-    glPushMatrix();
-    glTranslatef(0.2f, -1.0f, 0.0f);
-    glScalef(0.25f, 1.2f, 0.25f);
-    glutSolidCube(1.0f);
-    glPopMatrix();
 
-    glPopMatrix();
+void freeSoilImage(unsigned char* pixels) {
+    SOIL_free_image_data(pixels);
 }
-
-void drawAudience() {
-    for (auto& p : audience) {
-        p.jumpPhase += p.jumpSpeed;  // increment phase for faster jumping
-        drawPerson(p,0.1f);
-    }
+void drawAudience(void*) {
+    // Jump animation runs in the crowd shader from elapsed time
+    drawCrowd(glutGet(GLUT_ELAPSED_TIME) / 1000.0f, &visibleScenery.indices[SCENERY_PERSON]);
 }
 
-void drawStand(const Stand& s) {
-    glPushMatrix();
-    glTranslatef(s.x, 0.0f, s.z);
-
-    // base structure
-    glColor3f(0.7f, 0.7f, 0.7f);
-    glPushMatrix();
-    glScalef(s.width, s.height, s.depth);
-    glutSolidCube(1.0f);
-    glPopMatrix();
+void queueStaticScenery(const Frustum& frustum, float camX, float camZ) {
+    RenderState textured;
+    textured.texture = buildingTexture;
 
-    // roof
-    glColor3f(0.3f, 0.3f, 0.3f);
-    glPushMatrix();
-    glTranslatef(0.0f, s.height / 2.0f + 0.5f, 0.0f);
-    glScalef(s.width + 2, 1.0f, s.depth + 2);
-    glutSolidCube(1.0f);
-    glPopMatrix();
+    for (StaticChunkMeshes& chunk : staticChunks) {
+        const SceneryBounds& b = chunk.bounds;
+        if (!aabbInFrustum(frustum, b.minX, b.minY, b.minZ, b.maxX, b.maxY, b.maxZ)) continue;
 
-    glPopMatrix();
-}
-void drawBuildings() {
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, buildingTexture);
-
-    for (auto& b : buildings) {
-        float newHeight = b.height - 5.0f; // reduce height
-
-        glPushMatrix();
-        glTranslatef(b.x, newHeight / 2.0f, b.z); // move to center of building
-        glScalef(b.width, newHeight, b.depth);    // scale cube to building size
-        glColor3f(1.0f, 1.0f, 1.0f);
-
-        glBegin(GL_QUADS);
-        // Front face
-        glTexCoord2f(0, 0); glVertex3f(-0.5f, -0.5f, 0.5f);
-        glTexCoord2f(1, 0); glVertex3f(0.5f, -0.5f, 0.5f);
-        glTexCoord2f(1, 1); glVertex3f(0.5f, 0.5f, 0.5f);
-        glTexCoord2f(0, 1); glVertex3f(-0.5f, 0.5f, 0.5f);
-        // Back face
-        glTexCoord2f(0, 0); glVertex3f(-0.5f, -0.5f, -0.5f);
-        glTexCoord2f(1, 0); glVertex3f(0.5f, -0.5f, -0.5f);
-        glTexCoord2f(1, 1); glVertex3f(0.5f, 0.5f, -0.5f);
-        glTexCoord2f(0, 1); glVertex3f(-0.5f, 0.5f, -0.5f);
-        // Left face
-        glTexCoord2f(0, 0); glVertex3f(-0.5f, -0.5f, -0.5f);
-        glTexCoord2f(1, 0); glVertex3f(-0.5f, -0.5f, 0.5f);
-        glTexCoord2f(1, 1); glVertex3f(-0.5f, 0.5f, 0.5f);
-        glTexCoord2f(0, 1); glVertex3f(-0.5f, 0.5f, -0.5f);
-        // Right face
-        glTexCoord2f(0, 0); glVertex3f(0.5f, -0.5f, -0.5f);
-        glTexCoord2f(1, 0); glVertex3f(0.5f, -0.5f, 0.5f);
-        glTexCoord2f(1, 1); glVertex3f(0.5f, 0.5f, 0.5f);
-        glTexCoord2f(0, 1); glVertex3f(0.5f, 0.5f, -0.5f);
-        // Top face
-        glTexCoord2f(0, 0); glVertex3f(-0.5f, 0.5f, -0.5f);
-        glTexCoord2f(1, 0); glVertex3f(0.5f, 0.5f, -0.5f);
-        glTexCoord2f(1, 1); glVertex3f(0.5f, 0.5f, 0.5f);
-        glTexCoord2f(0, 1); glVertex3f(-0.5f, 0.5f, 0.5f);
-        // Bottom face
-        glTexCoord2f(0, 0); glVertex3f(-0.5f, -0.5f, -0.5f);
-        glTexCoord2f(1, 0); glVertex3f(0.5f, -0.5f, -0.5f);
-        glTexCoord2f(1, 1); glVertex3f(0.5f, -0.5f, 0.5f);
-        glTexCoord2f(0, 1); glVertex3f(-0.5f, -0.5f, 0.5f);
-        glEnd();
-
-        glPopMatrix();
+        setRenderPass(renderQueue, "buildings");
+        if (chunk.building.count > 0) queueMesh(renderQueue, RENDER_LAYER_OPAQUE, textured, chunk.building);
+        // Stands and track objects are merged into the same chunk meshes
+        setRenderPass(renderQueue, "standsAndObjects");
+        chunk.lod = selectLod(TRACK_OBJECT_LOD, staticChunkDistance(b, camX, camZ), chunk.lod);
+        if (chunk.colored[chunk.lod].count > 0) {
+            queueMesh(renderQueue, RENDER_LAYER_OPAQUE, RenderState(), chunk.colored[chunk.lod]);
+        }
     }
-
-    glDisable(GL_TEXTURE_2D);
 }
 
 
 
-void generateAudienceInStands() {
-    for (const auto& s : stands) {
-        int numPeople = 20 + rand() % 40;
-        for (int i = 0; i < numPeople; i++) {
-            Person p;
-            p.x = s.x + randf(-s.width / 2, s.width / 2);
-            p.z = s.z + randf(-s.depth / 2, s.depth / 2);
-            p.baseY = 1.0f; // elevate audience above ground
-            p.jumpPhase = randf(0, 6.28f);
-            p.r = randf(0.0f, 1.0f);
-            p.g = randf(0.0f, 1.0f);
-            p.b = randf(0.0f, 1.0f);
-            audience.push_back(p);
-        }
-    }
-}
-
 // ==================== LIGHTING ====================
 void setupLights() {
     glEnable(GL_LIGHTING);
@@ -473,473 +213,56 @@ Vec2 normalize(const Vec2& v) {
 }
 
 
-// ==================== DRAW WHEEL ====================
-void drawWheel(float radius, float width, int spokes) {
-    GLUquadric* q = gluNewQuadric();
-
-    glPushMatrix();
-    glRotatef(90, 0, 1, 0); // align tire along X-axis
-
-    // Tire tread (textured)
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, tireTexture);
-    gluQuadricTexture(q, GL_TRUE);
-    gluQuadricNormals(q, GLU_SMOOTH);
-    glColor3f(1.0f, 1.0f, 1.0f);
-    gluCylinder(q, radius, radius, width, 32, 1);
-    glDisable(GL_TEXTURE_2D);
-
-    // Front disk of tire (black)
-    gluQuadricTexture(q, GL_FALSE);
-    glColor3f(0.05f, 0.05f, 0.05f);
-    gluDisk(q, 0, radius, 32, 1);
-
-    // Back disk of tire (black)
-    glPushMatrix();
-    glTranslatef(0, 0, width);
-    gluDisk(q, 0, radius, 32, 1);
-    glPopMatrix();
-
-    // --- Draw alloy hub / rim (white) ---
-    float hubRadius = radius * 0.5f;
-    float hubThickness = width * 0.2f;
-    glColor3f(1.0f, 1.0f, 1.0f); // White rim
-    glPushMatrix();
-    glTranslatef(0, 0, width / 2.0f); // place in the middle of tire
-
-    // central disk
-    gluDisk(q, 0, hubRadius, 32, 1);
-
-    // spokes
-    for (int i = 0; i < spokes; i++) {
-        float angle = i * 360.0f / spokes;
-        glPushMatrix();
-        glRotatef(angle, 0, 0, 1); // rotate around hub axis
-        glTranslatef(hubRadius * 0.5f, 0, 0);
-        glScalef(hubRadius * 0.5f, hubRadius * 0.05f, hubThickness);
-        glutSolidCube(1.0f);
-        glPopMatrix();
-    }
-    glPopMatrix(); // end hub
-
-    glPopMatrix();
-    gluDeleteQuadric(q);
-}
-
-
-
-static void drawTexturedBox(float sx, float sy, float sz)
-{
-    glPushMatrix();
-    glScalef(sx, sy, sz);
-    glColor3f(1.0f, 1.0f, 1.0f); // don't tint the texture
-
-    glBegin(GL_QUADS);
-    // +Z (front)
-    glTexCoord2f(0.f, 0.f); glVertex3f(-0.5f, -0.5f, 0.5f);
-    glTexCoord2f(1.f, 0.f); glVertex3f(0.5f, -0.5f, 0.5f);
-    glTexCoord2f(1.f, 1.f); glVertex3f(0.5f, 0.5f, 0.5f);
-    glTexCoord2f(0.f, 1.f); glVertex3f(-0.5f, 0.5f, 0.5f);
-
-    // -Z (back)
-    glTexCoord2f(1.f, 0.f); glVertex3f(-0.5f, -0.5f, -0.5f);
-    glTexCoord2f(1.f, 1.f); glVertex3f(-0.5f, 0.5f, -0.5f);
-    glTexCoord2f(0.f, 1.f); glVertex3f(0.5f, 0.5f, -0.5f);
-    glTexCoord2f(0.f, 0.f); glVertex3f(0.5f, -0.5f, -0.5f);
-
-    // +X (right)
-    glTexCoord2f(0.f, 0.f); glVertex3f(0.5f, -0.5f, 0.5f);
-    glTexCoord2f(1.f, 0.f); glVertex3f(0.5f, -0.5f, -0.5f);
-    glTexCoord2f(1.f, 1.f); glVertex3f(0.5f, 0.5f, -0.5f);
-    glTexCoord2f(0.f, 1.f); glVertex3f(0.5f, 0.5f, 0.5f);
-
-    // -X (left)
-    glTexCoord2f(1.f, 0.f); glVertex3f(-0.5f, -0.5f, 0.5f);
-    glTexCoord2f(1.f, 1.f); glVertex3f(-0.5f, 0.5f, 0.5f);
-    glTexCoord2f(0.f, 1.f); glVertex3f(-0.5f, 0.5f, -0.5f);
-    glTexCoord2f(0.f, 0.f); glVertex3f(-0.5f, -0.5f, -0.5f);
-
-    // +Y (top)
-    glTexCoord2f(0.f, 1.f); glVertex3f(-0.5f, 0.5f, 0.5f);
-    glTexCoord2f(0.f, 0.f); glVertex3f(0.5f, 0.5f, 0.5f);
-    glTexCoord2f(1.f, 0.f); glVertex3f(0.5f, 0.5f, -0.5f);
-    glTexCoord2f(1.f, 1.f); glVertex3f(-0.5f, 0.5f, -0.5f);
-
-    // -Y (bottom)
-    glTexCoord2f(1.f, 1.f); glVertex3f(-0.5f, -0.5f, 0.5f);
-    glTexCoord2f(0.f, 1.f); glVertex3f(0.5f, -0.5f, 0.5f);
-    glTexCoord2f(0.f, 0.f); glVertex3f(0.5f, -0.5f, -0.5f);
-    glTexCoord2f(1.f, 0.f); glVertex3f(-0.5f, -0.5f, -0.5f);
-    glEnd();
-
-    glPopMatrix();
-}
-void drawF1Car() {
-    // --- Car Body ---
-    glPushMatrix();
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, carTex);
-    glColor3f(1.0f, 1.0f, 1.0f); // ensure texture is not tinted
-    glPushMatrix();
-    glTranslatef(0.0f, 1.0f, 0.0f);
-    drawTexturedBox(1.2f, 0.7f, 4.0f);
-    glPopMatrix();
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glDisable(GL_TEXTURE_2D);
-    glPopMatrix();
-
-    // --- Cockpit (textured) ---
-    glPushMatrix();
-    glTranslatef(0.0f, 1.1f, -0.5f);
-    glScalef(0.8f, 0.6f, 1.0f);
-    glColor3f(0.1f, 0.1f, 0.1f); // dark color for cockpit
-    glutSolidCube(1.0f); // simple dark cube for cockpit
-    glPopMatrix();
-    // --- Front wing (textured) ---
-    glPushMatrix();
-    glTranslatef(0.0f, 0.95f, 3.0f);
-    glScalef(2.0f, 0.1f, 0.4f);
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, carTex);
-    glColor3f(1.0f, 1.0f, 1.0f);
-    drawTexturedBox(1.0f, 1.0f, 1.0f);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glDisable(GL_TEXTURE_2D);
-    glPopMatrix();
-
-    // --- Rear wing supports ---
-    glPushMatrix();
-    glTranslatef(0.3f, 1.5f, -2.2f);
-    glScalef(0.1f, 0.8f, 0.1f);
-    glColor3f(0.3f, 0.5f, 0.05f);
-    glutSolidCube(1.0f);
-    glPopMatrix();
-
-    glPushMatrix();
-    glTranslatef(-0.3f, 1.5f, -2.2f);
-    glScalef(0.1f, 0.8f, 0.1f);
-    glutSolidCube(1.0f);
-    glPopMatrix();
-
-    // --- Rear wing (textured) ---
-    glPushMatrix();
-    glTranslatef(0.0f, 1.85f, -2.2f);
-    glScalef(1.8f, 0.1f, 0.3f);
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, carTex);
-    glColor3f(1.0f, 1.0f, 1.0f);
-    drawTexturedBox(1.0f, 1.0f, 1.0f);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glDisable(GL_TEXTURE_2D);
-    glPopMatrix();
-
-    // --- Driver helmet ---
-    glPushMatrix();
-    glTranslatef(0.0f, 1.5f, -0.6f);
-    GLUquadric* helmet = gluNewQuadric();
-    gluQuadricTexture(helmet, GL_TRUE);
-    gluQuadricNormals(helmet, GLU_SMOOTH);
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, helmetTex);
-    glColor3f(1.0f, 1.0f, 1.0f);
-    gluSphere(helmet, 0.25f, 32, 16);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glDisable(GL_TEXTURE_2D);
-    gluDeleteQuadric(helmet);
-    glPopMatrix();
-
-    // --- Nose cone (textured) ---
-    glPushMatrix();
-    glTranslatef(0.0f, 1.0f, 2.0f);
-    GLUquadric* nose = gluNewQuadric();
-    gluQuadricTexture(nose, GL_TRUE);
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, carTex);
-    glColor3f(1.0f, 1.0f, 1.0f);
-    gluCylinder(nose, 0.3f, 0.1f, 1.5f, 16, 16);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glDisable(GL_TEXTURE_2D);
-    gluDeleteQuadric(nose);
-    glPopMatrix();
-
-    // --- Front wing endplates ---
-    glPushMatrix();
-    glTranslatef(1.05f, 0.95f, 3.0f);
-    glScalef(0.05f, 0.5f, 0.3f);
-    glColor3f(0.0f, 0.0f, 0.0f);
-    glutSolidCube(1.0f);
-    glPopMatrix();
-
-    glPushMatrix();
-    glTranslatef(-1.05f, 0.95f, 3.0f);
-    glScalef(0.05f, 0.5f, 0.3f);
-    glutSolidCube(1.0f);
-    glPopMatrix();
-
-    // --- Wheels ---
-    float wheelY = 0.7f;
-    float wheelZFront = 1.7f;
-    float wheelZRear = -1.8f;
-    float wheelOffsetX = 1.5f;
-
-    auto drawWheelAndArm = [&](float x, float z, float radius, float width) {
-        // Suspension/arm
-        glPushMatrix();
-        glTranslatef(x * 0.7f, wheelY + 0.2f, z * 0.9f);
-        glRotatef(90.0f, 0.0f, 1.0f, 0.0f);
-        glScalef(0.2f, 0.1f, 0.8f);
-        glColor3f(0.1f, 0.1f, 0.1f);
-        glutSolidCube(1.0f);
-        glPopMatrix();
-
-        // Wheel
-        glPushMatrix();
-        glTranslatef(x, wheelY, z);
-        glRotatef(tireRotation * (carSpeed >= 0 ? 1 : -1), 1, 0, 0);
-        drawWheel(radius, width, 6); // 6-spoke alloy wheel
-        glPopMatrix();
-        };
-
-    drawWheelAndArm(wheelOffsetX - 0.5f, wheelZFront, 0.65f, 0.5f);
-    drawWheelAndArm(-wheelOffsetX, wheelZFront, 0.65f, 0.5f);
-    drawWheelAndArm(wheelOffsetX - 0.7f, wheelZRear, 0.65f, 0.7f);
-    drawWheelAndArm(-wheelOffsetX, wheelZRear, 0.65f, 0.7f);
-}
-
-void generateTrees(int numTrees) {
-    trees.clear();
-    for (int i = 0; i < numTrees; i++) {
-        int idx = rand() % innerTrack.size();
-        float dx = outerTrack[idx].first - innerTrack[idx].first;
-        float dz = outerTrack[idx].second - innerTrack[idx].second;
-        float len = sqrtf(dx * dx + dz * dz);
-        dx /= len; dz /= len;
-
-        float offset = TRACK_WIDTH * 4.0f + randf(10, 60);
-        float side = (rand() % 2 == 0 ? 1 : -1);
-
-        Tree t;
-        t.x = (innerTrack[idx].first + outerTrack[idx].first) * 0.5f + side * dx * offset;
-        t.z = (innerTrack[idx].second + outerTrack[idx].second) * 0.5f + side * dz * offset;
-        t.height = randf(8.0f, 16.0f);
-        t.radius = randf(0.5f, 1.2f);
-        trees.push_back(t);
-    }
-}
-
-void generateTrackObjects(int numObjects) {
-    trackObjects.clear();
-    for (int i = 0; i < numObjects; i++) {
-        int idx = rand() % innerTrack.size();
-
-        // Direction vector along track segment
-        float dx = outerTrack[(idx + 1) % innerTrack.size()].first - outerTrack[idx].first;
-        float dz = outerTrack[(idx + 1) % outerTrack.size()].second - outerTrack[idx].second;
-        float len = sqrtf(dx * dx + dz * dz);
-        dx /= len; dz /= len;
-
-        // Perpendicular vector to the track segment
-        float perpX = -dz;
-        float perpZ = dx;
-
-        // Random side (+/-) and offset distance
-        float side = (rand() % 2 == 0) ? 1.0f : -1.0f;  // left or right
-        float minOffset = TRACK_WIDTH * 1.2f;          // avoid middle of track
-        float maxOffset = TRACK_WIDTH * 4.0f;
-        float offset = minOffset + randf(0.0f, maxOffset - minOffset);
-
-        TrackObject o;
-        o.x = outerTrack[idx].first + perpX * offset * side;
-        o.z = outerTrack[idx].second + perpZ * offset * side;
-        o.type = rand() % 4; // pick random object type
-        trackObjects.push_back(o);
-    }
-}
-
-void drawTree(const Tree& t, GLuint leafTexture) {
-    glPushMatrix();
-    glTranslatef(t.x, 0.0f, t.z);  // Move tree to world position
-
-    // --- Draw Trunk ---
-    GLUquadric* quad = gluNewQuadric();
-    gluQuadricDrawStyle(quad, GLU_FILL);
-    gluQuadricNormals(quad, GLU_SMOOTH);
-
-    float trunkHeight = t.height * 0.08f;
-    float baseRadius = t.radius * 0.3f;
-    float topRadius = t.radius * 0.25f;
-
-    glRotatef(-90.0f, 1.0f, 0.0f, 0.0f);  // Keep your original trunk rotation
-    glColor3f(0.55f, 0.27f, 0.07f);
-    gluCylinder(quad, baseRadius, topRadius, trunkHeight, 16, 4);
-
-    // Cap the bottom
-    glPushMatrix();
-    glRotatef(180.0f, 1.0f, 0.0f, 0.0f);
-    gluDisk(quad, 0.0f, baseRadius, 16, 4);
-    glPopMatrix();
-
-    // --- Draw Canopy with texture ---
-    glTranslatef(0.0f, 0.0f, trunkHeight); // move to top of trunk
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, leafTexture);
-    glColor3f(1.0f, 1.0f, 1.0f); // White to preserve texture colors
-
-    int layers = 4;
-    for (int i = 0; i < layers; ++i) {
-        float layerHeight = (t.height * 0.6f) / layers;
-        float radius = t.radius * (5.0f - .3f * i);
-
-        glPushMatrix();
-        glTranslatef(0.0f, 0.0f, i * layerHeight * 0.8f);
-
-        GLUquadric* canopy = gluNewQuadric();
-        gluQuadricTexture(canopy, GL_TRUE);   // enable texturing
-        gluQuadricNormals(canopy, GLU_SMOOTH);
-        gluCylinder(canopy, radius, 0.0f, layerHeight * 1.4f, 20, 10);
-        gluDeleteQuadric(canopy);
-
-        glPopMatrix();
-    }
-
-    // --- Add textured top sphere ---
-    glPushMatrix();
-    glTranslatef(0.0f, 0.0f, layers * (t.height * 0.6f) / layers * 0.8f);
-
-    GLUquadric* topSphere = gluNewQuadric();
-    gluQuadricTexture(topSphere, GL_TRUE);
-    gluQuadricNormals(topSphere, GLU_SMOOTH);
-    gluSphere(topSphere, t.radius * 0.4f, 16, 16);
-    gluDeleteQuadric(topSphere);
-
-    glPopMatrix();
-
-    glDisable(GL_TEXTURE_2D);  // disable texture after drawing canopy
-    gluDeleteQuadric(quad);
-    glPopMatrix();
-}
-
+// ==================== DRAW CAR ====================
+const float CAR_RADIUS = 4.0f; // around the car's origin, wings and wheels included
+// The whole car is cached meshes: painted body, trim, helmet, and the two
+// wheel meshes placed per wheel with the current tire spin.
+void queueCar(const CarState& view, int lod) {
+    MeshTransform car;
+    car.translate(view.x, 0.0f, view.z);
+    car.rotate(view.angle, 0.0f, 1.0f, 0.0f);
 
+    setRenderPass(renderQueue, "car");
+    RenderState paint;
+    paint.texture = carTex;
+    queueMesh(renderQueue, RENDER_LAYER_OPAQUE, paint, carPaintMesh[lod], &car);
+    queueMesh(renderQueue, RENDER_LAYER_OPAQUE, RenderState(), carTrimMesh[lod], &car);
 
+    RenderState helmet;
+    helmet.texture = helmetTex;
+    MeshTransform helmetXf = car;
+    helmetXf.translate(0.0f, CAR_HELMET_Y, CAR_HELMET_Z);
+    queueMesh(renderQueue, RENDER_LAYER_OPAQUE, helmet, helmetMesh[lod], &helmetXf);
 
-void drawTrackObject(const TrackObject& o) {
-    glPushMatrix();
-    glTranslatef(o.x, 0.0f, o.z);
-
-    switch (o.type) {
-    case 0: // Tire stack
-        glColor3f(0.1f, 0.1f, 0.1f);
-        for (int i = 0; i < 3; i++) {
-            glPushMatrix();
-            glTranslatef(0.0f, i * 0.5f, 0.0f);
-            glutSolidTorus(0.15f, 0.4f, 16, 16);
-            glPopMatrix();
-        }
-        break;
-
-    case 1: // Barrier
-        glColor3f(0.9f, 0.1f, 0.1f);
-        glScalef(2.0f, 1.0f, 0.5f);
-        glutSolidCube(1.0f);
-        break;
-
-    case 2: // Lamp post
-        glColor3f(0.3f, 0.3f, 0.3f);
-        glPushMatrix();
-        glScalef(0.1f, 5.0f, 0.1f);
-        glutSolidCube(1.0f);
-        glPopMatrix();
-        glTranslatef(0.0f, 2.5f, 0.0f);
-        glColor3f(1.0f, 1.0f, 0.8f);
-        glutSolidSphere(0.3f, 16, 16);
-        break;
-
-    case 3: // Banner
-        glColor3f(0.0f, 0.0f, 1.0f);
-        glPushMatrix();
-        glScalef(4.0f, 2.0f, 0.2f);
-        glutSolidCube(1.0f);
-        glPopMatrix();
-        break;
+    RenderState tread;
+    tread.texture = tireTexture;
+    float spin = view.tireRotation * (view.speed >= 0 ? 1 : -1);
+    for (int w = 0; w < CAR_WHEELS; w++) {
+        MeshTransform wheel = car;
+        carWheelTransform(wheel, w, spin);
+        queueMesh(renderQueue, RENDER_LAYER_OPAQUE, tread, wheelTreadMesh[lod], &wheel);
+        queueMesh(renderQueue, RENDER_LAYER_OPAQUE, RenderState(), wheelBodyMesh[lod], &wheel);
     }
-    glPopMatrix();
 }
 
 // ==================== DRAW TRACK ====================
-void drawMiddleLine(float dashLength = 2.0f, float gapLength = 1.0f) {
-    if (innerTrack.empty() || outerTrack.empty()) return;
-
-    glDisable(GL_LIGHTING);
-    glColor3f(1.0f, 1.0f, 1.0f); // white line
-    glLineWidth(6.0f);
-
-    int n = (int)innerTrack.size();
-
-    for (int i = 0; i < n; i++) {
-        // Current and next middle point
-        int nextIdx = (i + 1) % n;
-        float x0 = (innerTrack[i].first + outerTrack[i].first) * 0.5f;
-        float z0 = (innerTrack[i].second + outerTrack[i].second) * 0.5f;
-        float x1 = (innerTrack[nextIdx].first + outerTrack[nextIdx].first) * 0.5f;
-        float z1 = (innerTrack[nextIdx].second + outerTrack[nextIdx].second) * 0.5f;
-
-        float dx = x1 - x0;
-        float dz = z1 - z0;
-        float segmentLength = sqrtf(dx * dx + dz * dz);
-
-        // Direction vector normalized
-        float dirX = dx / segmentLength;
-        float dirZ = dz / segmentLength;
-
-        float traveled = 0.0f;
-        bool drawDash = true;
-
-        while (traveled < segmentLength) {
-            float start = traveled;
-            float end = std::min(traveled + (drawDash ? dashLength : gapLength), segmentLength);
-
-            if (drawDash) {
-                glBegin(GL_LINES);
-                glVertex3f(x0 + dirX * start, 0.02f, z0 + dirZ * start);
-                glVertex3f(x0 + dirX * end, 0.02f, z0 + dirZ * end);
-                glEnd();
-            }
-
-            traveled = end;
-            drawDash = !drawDash;
-        }
-    }
-
-    glEnable(GL_LIGHTING);
-}
-void drawTrack() {
-    glDisable(GL_LIGHTING);
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, asphaltTex);
-
-    glColor3f(1.0f, 1.0f, 1.0f); // let texture color show
-
-    glBegin(GL_QUAD_STRIP);
-    int n = (int)innerTrack.size();
-    float texRepeat = 40.0f;  // repeat texture along track
-
-    for (int i = 0; i <= n; ++i) {
-        int idx = i % n;
-
-        float s = (i / (float)n) * texRepeat;
-
-        glTexCoord2f(s, 0.0f);
-        glVertex3f(outerTrack[idx].first, 0.01f, outerTrack[idx].second);
-
-        glTexCoord2f(s, 1.0f);
-        glVertex3f(innerTrack[idx].first, 0.01f, innerTrack[idx].second);
-    }
-    glEnd();
-
-    glDisable(GL_TEXTURE_2D);
-    glEnable(GL_LIGHTING);
-}
-void drawStartLine() {
+void queueTrack() {
+    RenderState surface;
+    surface.texture = asphaltTex;
+    surface.lighting = false;
+    setRenderPass(renderQueue, "track");
+    queueMesh(renderQueue, RENDER_LAYER_GROUND, surface, trackSurfaceMesh);
+
+    RenderState unlit;
+    unlit.lighting = false;
+    setRenderPass(renderQueue, "middleLine");
+    queueMesh(renderQueue, RENDER_LAYER_GROUND, unlit, middleLineMesh);
+    setRenderPass(renderQueue, "kerbs");
+    queueMesh(renderQueue, RENDER_LAYER_GROUND, RenderState(), kerbMesh);
+    setRenderPass(renderQueue, "trackTires");
+    queueInstanced(renderQueue, RENDER_LAYER_OPAQUE, RenderState(), barrierTireMesh, barrierTires);
+}
+void drawStartLine(void*) {
     int numCols = 16; // across width
     int numRows = 8;  // along track
     float widthScale = 1.1f; // wider than track
@@ -1047,103 +370,139 @@ void drawTire(float x, float y, float z, float radius = 0.35f, float width = 0.1
 
 
 
-// ==================== BUILD DISPLAY LISTS ====================
-void buildDisplayLists() {
-    if (trackList != 0) glDeleteLists(trackList, 1);
-    if (tireList != 0) glDeleteLists(tireList, 1);
+// ==================== BUILD TRACK MESHES ====================
+// Track geometry is static, so it is built and uploaded once per track.
+void buildTrackMeshes() {
+    Mesh mesh;
+    buildTrackSurfaceMesh(mesh);
+    uploadMesh(trackSurfaceMesh, mesh);
+    buildKerbMesh(mesh);
+    uploadMesh(kerbMesh, mesh);
+    buildMiddleLineMesh(mesh);
+    uploadMesh(middleLineMesh, mesh);
 
-    trackList = glGenLists(1);
-    glNewList(trackList, GL_COMPILE);
-    drawTrack();
-    glEndList();
+    // Barrier tires: cylinder turned to hang down from its top face
+    Mesh tire;
+    tire.useVertexColor = false;
+    MeshTransform tireXf;
+    tireXf.rotate(90.0f, 1.0f, 0.0f, 0.0f);
+    appendCylinder(tire, tireXf, BARRIER_TIRE_RADIUS, BARRIER_TIRE_RADIUS, BARRIER_TIRE_WIDTH, 12, 3);
+    uploadMesh(barrierTireMesh, tire);
 
-    tireList = glGenLists(1);
-    glNewList(tireList, GL_COMPILE);
-    //placeTires();
-    glEndList();
+    std::vector<MeshInstance> tires;
+    buildTireBarrierInstances(tires);
+    uploadInstances(barrierTires, tires);
 }
 
-// ==================== CAR MOVEMENT ====================
-void resetCar() {
-    // Place car on the start line
-    carX = startLineCenter.first;
-    carZ = startLineCenter.second;
-    carAngle = startLineAngle; // face along track direction
-    carSpeed = 0.0f;
-
-    tireRotation = 0.0f; // reset wheel rotation if needed
+// ==================== BUILD SCENERY MESHES ====================
+// Ground quad.
+void buildSceneryMeshes() {
+    Mesh ground;
+    ground.useVertexColor = false;
+    float R = 500.0f;
+    float texRepeat = 50.0f;
+    MeshVertex a = makeVertex(-R, 0.0f, -R, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f);
+    MeshVertex b = makeVertex(R, 0.0f, -R, 0.0f, 1.0f, 0.0f, texRepeat, 0.0f);
+    MeshVertex c = makeVertex(R, 0.0f, R, 0.0f, 1.0f, 0.0f, texRepeat, texRepeat);
+    MeshVertex d = makeVertex(-R, 0.0f, R, 0.0f, 1.0f, 0.0f, 0.0f, texRepeat);
+    ground.vertices = { a, b, c, a, c, d };
+    uploadMesh(groundMesh, ground);
+}
+
+// Static scenery is merged on the CPU, uploaded, and the CPU copy dropped.
+void buildStaticBatches() {
+    StaticBatch batch;
+    buildStaticBatch(batch);
+
+    for (StaticChunkMeshes& chunk : staticChunks) {
+        releaseMesh(chunk.building);
+        for (GpuMesh& mesh : chunk.colored) releaseMesh(mesh);
+    }
+    staticChunks.clear();
+    staticChunks.resize(batch.chunks.size());
+    for (size_t i = 0; i < batch.chunks.size(); i++) {
+        const StaticChunk& src = batch.chunks[i];
+        StaticChunkMeshes& chunk = staticChunks[i];
+        chunk.bounds = src.bounds;
+        uploadMesh(chunk.building, src.building);
+        for (int lod = 0; lod < TRACK_OBJECT_LOD_LEVELS; lod++) uploadMesh(chunk.colored[lod], src.colored[lod]);
+    }
+}
+
+// ==================== BUILD LOD MESHES ====================
+// Every level of the car parts, uploaded once.
+void buildLodMeshes() {
+    Mesh tread, body;
+    for (int lod = 0; lod < CAR_LOD_LEVELS; lod++) {
+        buildWheelMeshes(lod, 6, tread, body); // 6-spoke alloy wheel
+        uploadMesh(wheelTreadMesh[lod], tread);
+        uploadMesh(wheelBodyMesh[lod], body);
+        buildHelmetMesh(lod, body);
+        uploadMesh(helmetMesh[lod], body);
+        buildCarBodyMeshes(lod, tread, body);
+        uploadMesh(carPaintMesh[lod], tread);
+        uploadMesh(carTrimMesh[lod], body);
+    }
 }
 
+// ==================== CAR MOVEMENT ====================
+// Before every physics substep, on the simulation thread: the AI drives
+// every car but the player's, spread over the worker pool.
+void driveOpponents(VehicleSet& set, void*) {
+    driveAiCarsParallel(workerPool, racingLine, aiDrivers, set, 1);
+}
+
+void resetCars() {
+    stopSimThread(sim);
+    resizeVehicles(sim.cars, carCount);
+    placeVehiclesOnGrid(sim.cars, trackIndex);
+    resetAiDrivers(aiDrivers, racingLine, sim.cars);
+    sim.prev = sim.cars;
+    sim.clock.accumulator = 0.0f;
+    sim.track = &trackIndex;
+    sim.collision = &collisionWorld;
+    sim.control = driveOpponents;
+    carLods.assign(carCount, -1);
+    startSimThread(sim);
+}
+
+// Physics runs on its own thread at sim.clock's rate; GLUT only draws
 void idleFunc() {
-    int currentTime = glutGet(GLUT_ELAPSED_TIME);
-    float deltaTime = (currentTime - lastTime) / 1000.0f;
-    lastTime = currentTime;
-
-    if (deltaTime > 0.1f) deltaTime = 0.1f; // clamp deltaTime
-
-    // --- Update car speed ---
-    if (moveForward) {
-        carSpeed += ACCELERATION * deltaTime;
-        if (carSpeed > MAX_SPEED_FW) carSpeed = MAX_SPEED_FW;
-    }
-    else if (moveBackward) {
-        carSpeed -= ACCELERATION * deltaTime;
-        if (carSpeed < -MAX_SPEED_BW) carSpeed = -MAX_SPEED_BW;
-    }
-    else {
-        if (carSpeed > 0.0f) {
-            carSpeed -= FRICTION * deltaTime;
-            if (carSpeed < 0.0f) carSpeed = 0.0f;
-        }
-        else if (carSpeed < 0.0f) {
-            carSpeed += FRICTION * deltaTime;
-            if (carSpeed > 0.0f) carSpeed = 0.0f;
-        }
-    }
+    glutPostRedisplay();
+}
 
-    // --- Update car rotation ---
-    float turnSpeed = TURN_ANGLE * deltaTime;
-    if (moveLeft) carAngle += turnSpeed;
-    if (moveRight) carAngle -= turnSpeed;
-    if (carAngle > 180.0f) carAngle -= 360.0f;
-    if (carAngle < -180.0f) carAngle += 360.0f;
-
-    // --- Update car position ---
-    float rad = carAngle * M_PI_F / 180.0f;
-    float distance = carSpeed * deltaTime;
-    carX += distance * sinf(rad);
-    carZ += distance * cosf(rad);
-
-    // --- Update tire rotation ---
-    float wheelRadius = 0.3f; // adjust according to your wheel size
-    float wheelCircumference = 2.0f * M_PI_F * wheelRadius;
-    float rotationDelta = (distance / wheelCircumference) * 360.0f; // degrees
-    tireRotation += rotationDelta; // don't multiply by deltaTime or 50
-    if (tireRotation > 360.0f) tireRotation -= 360.0f;
-    if (tireRotation < -360.0f) tireRotation += 360.0f;
+// Before exit() tears down the track and AI state the thread reads
+void stopSimAtExit() {
+    stopSimThread(sim);
+}
 
-    glutPostRedisplay();
+// Before exit() destroys the texture loader's queues the workers finish
+// into; registered ahead of stopSimAtExit() so it runs after it, once the
+// simulation no longer hands the pool work
+void stopWorkersAtExit() {
+    stopThreadPool(workerPool);
 }
 
 
 // ==================== INPUT ====================
 void keyDown(unsigned char key, int, int) {
     switch (key) {
-    case 'w': case 'W': moveForward = true; break;
-    case 's': case 'S': moveBackward = true; break;
-    case 'a': case 'A': moveLeft = true; break;
-    case 'd': case 'D': moveRight = true; break;
-    case 'r': case 'R': resetCar(); break;
+    case 'w': case 'W': pushSimInput(sim, SIM_INPUT_FORWARD, true); break;
+    case 's': case 'S': pushSimInput(sim, SIM_INPUT_BACKWARD, true); break;
+    case 'a': case 'A': pushSimInput(sim, SIM_INPUT_LEFT, true); break;
+    case 'd': case 'D': pushSimInput(sim, SIM_INPUT_RIGHT, true); break;
+    case 'r': case 'R': resetCars(); break;
+    case 'p': case 'P': if (profileTracePath) writeChromeTrace(profileTracePath); break;
     case 27: exit(0); // ESC
     }
 }
 
 void keyUp(unsigned char key, int, int) {
     switch (key) {
-    case 'w': case 'W': moveForward = false; break;
-    case 's': case 'S': moveBackward = false; break;
-    case 'a': case 'A': moveLeft = false; break;
-    case 'd': case 'D': moveRight = false; break;
+    case 'w': case 'W': pushSimInput(sim, SIM_INPUT_FORWARD, false); break;
+    case 's': case 'S': pushSimInput(sim, SIM_INPUT_BACKWARD, false); break;
+    case 'a': case 'A': pushSimInput(sim, SIM_INPUT_LEFT, false); break;
+    case 'd': case 'D': pushSimInput(sim, SIM_INPUT_RIGHT, false); break;
     }
 }
 void specialKeyDown(int key, int, int) {
@@ -1159,210 +518,6 @@ void specialKeyDown(int key, int, int) {
 }
 
 
-void generateTrackPoints() {
-    innerTrack.clear();
-    outerTrack.clear();
-    std::vector<std::pair<float, float>> centerline;
-
-    const int numSegments = 10;
-    const float minStraight = 30.0f;
-    const float maxStraight = 80.0f;
-    const float minCurveRadius = 30.0f;
-    const float maxCurveRadius = 80.0f;
-
-    float angle = 0.0f;
-    float x = 0.0f, z = 0.0f;
-
-    // --- Generate rough track path ---
-    for (int s = 0; s < numSegments; s++) {
-        // Straight
-        float straightLen = minStraight + ((float)rand() / RAND_MAX) * (maxStraight - minStraight);
-        float dx = cosf(angle * M_PI_F / 180.0f);
-        float dz = sinf(angle * M_PI_F / 180.0f);
-
-        int stepsStraight = (int)(straightLen / 5.0f);
-        for (int i = 0; i < stepsStraight; i++) {
-            x += dx * 5.0f;
-            z += dz * 5.0f;
-            centerline.push_back({ x, z });
-        }
-
-        // Curve
-        int turnDir = (rand() % 2 == 0 ? -1 : 1);
-        float turnAngle = 45.0f + ((float)rand() / RAND_MAX) * 75.0f; // 45–120°
-        float curveRadius = minCurveRadius + ((float)rand() / RAND_MAX) * (maxCurveRadius - minCurveRadius);
-        int stepsCurve = 20;
-
-        float arcStep = (M_PI_F * curveRadius * (turnAngle / 360.0f)) / stepsCurve;
-
-        for (int i = 0; i < stepsCurve; i++) {
-            angle += turnDir * (turnAngle / stepsCurve);
-            dx = cosf(angle * M_PI_F / 180.0f);
-            dz = sinf(angle * M_PI_F / 180.0f);
-            x += dx * arcStep;
-            z += dz * arcStep;
-            centerline.push_back({ x, z });
-        }
-    }
-
-    // --- Close loop smoothly without duplicating the first point ---
-    centerline.push_back({
-        (centerline.back().first + centerline[0].first) * 0.5f,
-        (centerline.back().second + centerline[0].second) * 0.5f
-        });
-
-    // --- Smooth with Catmull-Rom ---
-    std::vector<std::pair<float, float>> smoothLine;
-    for (size_t i = 0; i < centerline.size(); ++i) {
-        std::pair<float, float> p0 = (i == 0) ? centerline[i] : centerline[i - 1];
-        std::pair<float, float> p1 = centerline[i];
-        std::pair<float, float> p2 = (i + 1 < centerline.size()) ? centerline[i + 1] : centerline[0];
-        std::pair<float, float> p3 = (i + 2 < centerline.size()) ? centerline[i + 2] : centerline[1];
-
-        int interpSteps = 10;
-        for (int t = 0; t < interpSteps; ++t) {
-            float alpha = t / (float)interpSteps;
-            smoothLine.push_back(catmullRom(p0, p1, p2, p3, alpha));
-        }
-    }
-
-    // --- Resample evenly for physics/AI ---
-    std::vector<std::pair<float, float>> resampled;
-    float stepSize = 2.0f; // spacing between samples
-    float dist = 0.0f;
-
-    resampled.push_back(smoothLine[0]);
-    for (size_t i = 1; i < smoothLine.size(); ++i) {
-        float dx = smoothLine[i].first - smoothLine[i - 1].first;
-        float dz = smoothLine[i].second - smoothLine[i - 1].second;
-        float segLen = sqrtf(dx * dx + dz * dz);
-        dist += segLen;
-
-        if (dist >= stepSize) {
-            resampled.push_back(smoothLine[i]);
-            dist = 0.0f;
-        }
-    }
-
-    // --- Build inner/outer edges ---
-    for (size_t i = 0; i < resampled.size(); i++) {
-        size_t j = (i + 1) % resampled.size();
-        float dx = resampled[j].first - resampled[i].first;
-        float dz = resampled[j].second - resampled[i].second;
-
-        float len = sqrtf(dx * dx + dz * dz);
-        if (len == 0) len = 1;
-        dx /= len;
-        dz /= len;
-
-        float px = -dz;
-        float pz = dx;
-
-        float innerX = resampled[i].first - px * (TRACK_WIDTH * 0.5f);
-        float innerZ = resampled[i].second - pz * (TRACK_WIDTH * 0.5f);
-        float outerX = resampled[i].first + px * (TRACK_WIDTH * 0.5f);
-        float outerZ = resampled[i].second + pz * (TRACK_WIDTH * 0.5f);
-
-        innerTrack.push_back({ innerX, innerZ });
-        outerTrack.push_back({ outerX, outerZ });
-    }
-
-    // --- Choose a clean start/finish line a bit into the track ---
-    int spawnIndex = 10; // skip first few to avoid overlap
-    startLineCenter = resampled[spawnIndex]; 
-    size_t nextIndex = (spawnIndex + 1) % resampled.size();
-    float dx = resampled[nextIndex].first - startLineCenter.first;
-    float dz = resampled[nextIndex].second - startLineCenter.second;
-    startLineAngle = atan2f(dz, dx) * 180.0f / M_PI_F; // degrees for OpenGL// <-- store for car spawn
-    float rotationOffset = 90.0f; // degrees
-    startLineAngle += rotationOffset;
-}
-
-
-
-
-void drawKerbs() {
-    if (innerTrack.empty() || outerTrack.empty()) return;
-
-    int n = (int)innerTrack.size();
-    float kerbWidth = 2.0f; // how far outside the track
-    float kerbHeight = 0.2f;
-
-    for (int i = 0; i < n; i++) {
-        int j = (i + 1) % n;
-
-        // Inner edge
-        {
-            float x1 = innerTrack[i].first;
-            float z1 = innerTrack[i].second;
-            float x2 = innerTrack[j].first;
-            float z2 = innerTrack[j].second;
-
-            // Outward offset for kerb
-            float dx = x2 - x1;
-            float dz = z2 - z1;
-            float len = sqrtf(dx * dx + dz * dz);
-            if (len == 0) len = 1;
-            dx /= len;
-            dz /= len;
-
-            // Perpendicular inward
-            float px = dz;
-            float pz = -dx;
-
-            float kx1 = x1 - px * kerbWidth;
-            float kz1 = z1 - pz * kerbWidth;
-            float kx2 = x2 - px * kerbWidth;
-            float kz2 = z2 - pz * kerbWidth;
-
-            if (i % 2 == 0) glColor3f(1.0f, 0.0f, 0.0f); // red
-            else glColor3f(1.0f, 1.0f, 1.0f);           // white
-
-            glBegin(GL_QUADS);
-            glVertex3f(x1, kerbHeight, z1);
-            glVertex3f(x2, kerbHeight, z2);
-            glVertex3f(kx2, kerbHeight, kz2);
-            glVertex3f(kx1, kerbHeight, kz1);
-            glEnd();
-        }
-
-        // Outer edge
-        {
-            float x1 = outerTrack[i].first;
-            float z1 = outerTrack[i].second;
-            float x2 = outerTrack[j].first;
-            float z2 = outerTrack[j].second;
-
-            float dx = x2 - x1;
-            float dz = z2 - z1;
-            float len = sqrtf(dx * dx + dz * dz);
-            if (len == 0) len = 1;
-            dx /= len;
-            dz /= len;
-
-            // Perpendicular outward
-            float px = -dz;
-            float pz = dx;
-
-            float kx1 = x1 + px * kerbWidth;
-            float kz1 = z1 + pz * kerbWidth;
-            float kx2 = x2 + px * kerbWidth;
-            float kz2 = z2 + pz * kerbWidth;
-
-            if (i % 2 == 0) glColor3f(1.0f, 0.0f, 0.0f); // red
-            else glColor3f(1.0f, 1.0f, 1.0f);           // white
-
-            glBegin(GL_QUADS);
-            glVertex3f(x1, kerbHeight, z1);
-            glVertex3f(x2, kerbHeight, z2);
-            glVertex3f(kx2, kerbHeight, kz2);
-            glVertex3f(kx1, kerbHeight, kz1);
-            glEnd();
-        }
-    }
-}
-
-
 //void drawFinishLine() {
 //    if (innerTrack.empty() || outerTrack.empty()) return;
 //
@@ -1392,137 +547,12 @@ void drawKerbs() {
 //    }
 //}
 
-void placeTreesAndObjects(int numItems, bool isTree) {
-    if (isTree) trees.clear();
-    else trackObjects.clear();
-
-    int totalSegments = outerTrack.size();
-
-    for (int i = 0; i < numItems; i++) {
-        int idx = rand() % totalSegments;
-        size_t nextIdx = (idx + 1) % totalSegments;
-
-        // Compute direction of track segment
-        float dx = outerTrack[nextIdx].first - outerTrack[idx].first;
-        float dz = outerTrack[nextIdx].second - outerTrack[idx].second;
-        float len = sqrtf(dx * dx + dz * dz);
-        if (len == 0) continue; // skip zero-length segments
-        dx /= len; dz /= len;
-
-        // Perpendicular vector
-        float px = -dz;
-        float pz = dx;
-
-        // Skip sharp curves: compute angle between consecutive segments
-        size_t prevIdx = (idx + totalSegments - 1) % totalSegments;
-        float pdx = outerTrack[idx].first - outerTrack[prevIdx].first;
-        float pdz = outerTrack[idx].second - outerTrack[prevIdx].second;
-        float plen = sqrtf(pdx * pdx + pdz * pdz);
-        if (plen == 0) plen = 1;
-        pdx /= plen; pdz /= plen;
-
-        float dot = dx * pdx + dz * pdz; // cosine of angle
-        if (dot < 0.5f) { // skip very sharp curves
-            i--;
-            continue;
-        }
-
-        // Random side
-        float side = (rand() % 2 == 0) ? 1.0f : -1.0f;
-
-        // Offset: start just outside track + some random variation
-        float minOffset = TRACK_WIDTH * 1.0f;
-        float maxOffset = TRACK_WIDTH * 4.0f;
-        float offset = minOffset + randf(0.0f, maxOffset - minOffset);
-        
-        float xPos = outerTrack[idx].first + px * offset * side;
-        float zPos = outerTrack[idx].second + pz * offset * side;
-
-        if (isTree) {
-            Tree t;
-            t.x = xPos;
-            t.z = zPos;
-            t.height = randf(8.0f, 15.0f);  // keep original heights
-            t.radius = randf(0.5f, 1.0f);   // slimmer trees
-            trees.push_back(t);
-        }
-        else {
-            TrackObject o;
-            o.x = xPos;
-            o.z = zPos;
-            o.type = rand() % 4;
-            trackObjects.push_back(o);
-        }
-    }
+// ==================== QUEUED PASSES ====================
+void drawVisibleTrees(void* data) {
+    const float* camera = (const float*)data; // x, z
+    drawTrees(camera[0], camera[1], treeTexture, &visibleScenery.indices[SCENERY_TREE]);
 }
-void drawTrackTires() {
-    GLUquadric* quad = gluNewQuadric();
-    float tireRadius = 0.4f;
-    float tireWidth = 0.3f;
-    int stackHeight = 3;
-    float spacing = 2.0f;
-
-    float innerOffset = 0.2f; // smaller, closer to inner edge
-    float outerOffset = -0.7f; // larger, leaning toward track
-
-    auto drawStack = [&](float x, float z, float angle, bool leanInward, float offset) {
-        float rad = angle * M_PI_F / 180.0f;
-        float px = -sinf(rad);
-        float pz = cosf(rad);
-
-        if (leanInward) { px *= -1; pz *= -1; }
-
-        x += px * offset;
-        z += pz * offset;
-
-        for (int h = 0; h < stackHeight; h++) {
-            glPushMatrix();
-            glTranslatef(x, tireRadius + h * tireWidth, z);
-            glRotatef(angle, 0, 1, 0);
-            glRotatef(90.0f, 1, 0, 0);
-            if (h % 2 == 0) glColor3f(1, 0, 0);
-            else glColor3f(1, 1, 1);
-            gluCylinder(quad, tireRadius, tireRadius, tireWidth, 12, 3);
-            glPopMatrix();
-        }
-        };
-
-    // --- Inner track ---
-    for (size_t i = 0; i < innerTrack.size(); i++) {
-        size_t next = (i + 1) % innerTrack.size();
-        float dx = innerTrack[next].first - innerTrack[i].first;
-        float dz = innerTrack[next].second - innerTrack[i].second;
-        float segLen = sqrtf(dx * dx + dz * dz);
-        dx /= segLen; dz /= segLen;
-        float angleDeg = atan2f(dz, dx) * 180.0f / M_PI_F;
-
-        int numStacks = (int)(segLen / spacing);
-        for (int s = 0; s < numStacks; s++) {
-            float x = innerTrack[i].first + dx * s * spacing;
-            float z = innerTrack[i].second + dz * s * spacing;
-            drawStack(x, z, angleDeg, false, innerOffset); // use inner offset
-        }
-    }
 
-    // --- Outer track ---
-    for (size_t i = 0; i < outerTrack.size(); i++) {
-        size_t next = (i + 1) % outerTrack.size();
-        float dx = outerTrack[next].first - outerTrack[i].first;
-        float dz = outerTrack[next].second - outerTrack[i].second;
-        float segLen = sqrtf(dx * dx + dz * dz);
-        dx /= segLen; dz /= segLen;
-        float angleDeg = atan2f(dz, dx) * 180.0f / M_PI_F;
-
-        int numStacks = (int)(segLen / spacing);
-        for (int s = 0; s < numStacks; s++) {
-            float x = outerTrack[i].first + dx * s * spacing;
-            float z = outerTrack[i].second + dz * s * spacing;
-            drawStack(x, z, angleDeg, true, outerOffset); // use outer offset
-        }
-    }
-
-    gluDeleteQuadric(quad);
-}
 // ==================== RESHAPE & INIT ====================
 void reshape(int w, int h) {
     if (h == 0) h = 1;
@@ -1540,63 +570,96 @@ void display() {
     
     static float t = 0.0f;
     t += 0.05f;
+    profileNextFrame();
+    profileDrainThreadEvents(); // the simulation thread's steps
+    gpuProfileNextFrame();
+    PROFILE_SCOPE("frame");
+    pumpTextureUploads();
+
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glMatrixMode(GL_MODELVIEW);
     glLoadIdentity();
 
+    // Blend the newest snapshot's two physics states so motion is smooth
+    // between steps
+    const SimSnapshot& snapshot = latestSnapshot(sim.snapshots);
+    const VehicleSet& cars = snapshot.cars;
+    float alpha = snapshotAlpha(snapshot, profileNowNs());
+    CarState view = interpolateVehicle(snapshot.prev, cars, 0, alpha);
+
     // Camera follows behind the car
-    float rad = (carAngle - camYawOffset) * M_PI_F / 180.0f;
+    float rad = (view.angle - camYawOffset) * M_PI_F / 180.0f;
     float camDist = 12.0f;
-    float camX = carX - camDist * sinf(rad);
-    float camZ = carZ - camDist * cosf(rad);
+    float camX = view.x - camDist * sinf(rad);
+    float camZ = view.z - camDist * cosf(rad);
     float camY = 6.0f + sinf(camPitchOffset * M_PI_F / 180.0f) * 4.0f;
 
-    gluLookAt(camX, camY, camZ, carX, 1.0f, carZ, 0, 1, 0);
-
-    // Ground plane
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, grassTex);
-    glDisable(GL_LIGHTING);
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glBegin(GL_QUADS);
-    float R = 500.0f;
-    float texRepeat = 50.0f;
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(-R, 0.0f, -R);
-    glTexCoord2f(texRepeat, 0.0f); glVertex3f(R, 0.0f, -R);
-    glTexCoord2f(texRepeat, texRepeat); glVertex3f(R, 0.0f, R);
-    glTexCoord2f(0.0f, texRepeat); glVertex3f(-R, 0.0f, R);
-    glEnd();
-
-    glEnable(GL_LIGHTING);
-    glDisable(GL_TEXTURE_2D);
+    gluLookAt(camX, camY, camZ, view.x, 1.0f, view.z, 0, 1, 0);
+
+    // Only scenery inside the view frustum is drawn this frame
+    Frustum frustum;
+    {
+        PROFILE_SCOPE("cull");
+        float proj[16], modelview[16];
+        glGetFloatv(GL_PROJECTION_MATRIX, proj);
+        glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+        extractFrustum(frustum, proj, modelview);
+        cullSpatialGrid(sceneryGrid, frustum, visibleScenery);
+    }
+
+    // Everything is queued first and drawn sorted by state
+    float treeCamera[2] = { camX, camZ };
+    {
+        PROFILE_SCOPE("queue");
+        RenderState ground;
+        ground.texture = grassTex;
+        ground.lighting = false;
+        setRenderPass(renderQueue, "ground");
+        queueMesh(renderQueue, RENDER_LAYER_GROUND, ground, groundMesh);
+
+        queueTrack();
+        setRenderPass(renderQueue, "startLine");
+        queueCallback(renderQueue, RENDER_LAYER_GROUND, RenderState(), drawStartLine);
+        queueStaticScenery(frustum, camX, camZ);
+
+        for (int i = 0; i < cars.count; i++) {
+            CarState c = i == 0 ? view : interpolateVehicle(snapshot.prev, cars, i, alpha);
+            if (!aabbInFrustum(frustum, c.x - CAR_RADIUS, 0.0f, c.z - CAR_RADIUS,
+                c.x + CAR_RADIUS, 2.0f, c.z + CAR_RADIUS)) continue;
+            float carDx = c.x - camX, carDy = 1.0f - camY, carDz = c.z - camZ;
+            carLods[i] = (signed char)selectLod(CAR_LOD, sqrtf(carDx * carDx + carDy * carDy + carDz * carDz), carLods[i]);
+            queueCar(c, carLods[i]);
+        }
 
-    // Draw track display list
-    if (trackList != 0) {
-        glCallList(trackList);
+        setRenderPass(renderQueue, "audience");
+        queueCallback(renderQueue, RENDER_LAYER_SHADER, RenderState(), drawAudience);
+        setRenderPass(renderQueue, "trees");
+        queueCallback(renderQueue, RENDER_LAYER_SHADER, RenderState(), drawVisibleTrees, treeCamera);
+    }
+    { PROFILE_PASS("draw"); flushRenderQueue(renderQueue); }
+
+    // What sorting by state saved this frame, as graphs in the trace
+    const RenderQueueStats& drawStats = renderQueue.stats;
+    profileCounter("draw_items", drawStats.items);
+    profileCounter("texture_binds", drawStats.textureBinds);
+    profileCounter("texture_toggles", drawStats.textureToggles);
+    profileCounter("lighting_toggles", drawStats.lightingToggles);
+
+    {
+        PROFILE_SCOPE("swap");
+        glutSwapBuffers();
+    }
+
+    // Key to screen: from the newest key event the cars have seen to the
+    // swap that first shows it
+    static long long shownInputNs = 0;
+    if (snapshot.inputNs != shownInputNs) {
+        shownInputNs = snapshot.inputNs;
+        if (profilerEnabled && shownInputNs != 0) {
+            profileRecord("input_latency", shownInputNs, profileNowNs() - shownInputNs,
+                PROFILE_TRACK_CPU, 0, profileFrame());
+        }
     }
-    drawTrackTires();
-    // Draw kerbs and finish line
-    drawKerbs();
-  //  drawFinishLine();
-    drawStartLine();   // <-- draws your black-and-white start line
-    drawBuildings();
-    // Draw car
-    glPushMatrix();
-    glTranslatef(carX, 0.0f, carZ);
-    glRotatef(carAngle, 0, 1, 0);
-    drawF1Car();
-    glPopMatrix();
-
-    drawAudience();
-    for (const auto& s : stands) drawStand(s);
-    for (const auto& t : trees) drawTree(t,treeTexture);
-    for (const auto& o : trackObjects) drawTrackObject(o);
-
-    glCallList(trackList);
-    drawMiddleLine();
-
-    glutSwapBuffers();
 }
 
 void initGL() {
@@ -1604,49 +667,55 @@ void initGL() {
     glEnable(GL_DEPTH_TEST);
     glShadeModel(GL_SMOOTH);
     glEnable(GL_NORMALIZE);
+    glLineWidth(6.0f); // middle line
 
-    grassTex = loadTexture("grass.jpg");
-    asphaltTex = loadTexture("asphalt.jpg");
-    tireTexture = loadTexture("tire.jpg");
-	carTex = loadTexture("car.jpg");
-	helmetTex = loadTexture("helmut.jpg");
-    treeTexture = loadTexture("trees.jpg");
-    buildingTexture = loadTexture("building.jpg");
-
-
-
-    setupLights();
-    lastTime = glutGet(GLUT_ELAPSED_TIME);
+    loadGLExtensions();
 
-    generateTrackPoints();
-    generateAllAudience();
-    buildDisplayLists();
-    generateTrees(80);
+    // Decoded (or read baked) on the workers while the world is built
+    // below; until each arrives its texture is a flat color close to the
+    // image's average
+    startThreadPool(workerPool, defaultWorkerCount());
+    initTextureLoader(workerPool, decodeSoilImage, freeSoilImage);
+    grassTex = loadTextureAsync("grass.jpg", 70, 120, 45);
+    asphaltTex = loadTextureAsync("asphalt.jpg", 90, 90, 90);
+    tireTexture = loadTextureAsync("tire.jpg", 35, 35, 35);
+    carTex = loadTextureAsync("car.jpg", 170, 30, 30);
+    helmetTex = loadTextureAsync("helmut.jpg", 200, 200, 200);
+    treeTexture = loadTextureAsync("trees.jpg", 50, 90, 40);
+    buildingTexture = loadTextureAsync("building.jpg", 140, 130, 120);
 
 
-    placeTreesAndObjects(80, true);   // generate 80 trees
-    placeTreesAndObjects(40, false);   // about 40 random objects
-    float trackMinX = 1e6f, trackMaxX = -1e6f;
-    float trackMinZ = 1e6f, trackMaxZ = -1e6f;
 
-    for (auto& p : innerTrack) {
-        if (p.first < trackMinX) trackMinX = p.first;
-        if (p.first > trackMaxX) trackMaxX = p.first;
-        if (p.second < trackMinZ) trackMinZ = p.second;
-        if (p.second > trackMaxZ) trackMaxZ = p.second;
-    }
+    setupLights();
 
-    for (auto& p : outerTrack) {
-        if (p.first < trackMinX) trackMinX = p.first;
-        if (p.first > trackMaxX) trackMaxX = p.first;
-        if (p.second < trackMinZ) trackMinZ = p.second;
-        if (p.second > trackMaxZ) trackMaxZ = p.second;
+    initInstancedRenderer();
+    initCrowdRenderer();
+    initTreeRenderer();
+    initGpuProfiler();
+    buildLodMeshes();
+    buildSceneryMeshes();
+    if (!worldCachePath || !loadWorldCache(worldCachePath, getWorldSeed(), audienceSize)) {
+        generateWorld();
+        if (audienceSize != NUM_AUDIENCE) generateAudience(audienceSize);
+        if (worldCachePath) saveWorldCache(worldCachePath, audienceSize);
     }
-    generateBuildings(50, trackMinX, trackMaxX, trackMinZ, trackMaxZ, 10.0f);
+    buildTrackMeshes();
+    uploadCrowd(audience);
+    uploadTrees(trees);
+    buildSceneryGrid(sceneryGrid);
+    buildTrackIndex(trackIndex);
+    buildRacingLine(racingLine, trackSpline);
+    buildCollisionWorld(collisionWorld, trackIndex);
+    buildStaticBatches();
 
 }
 
 
+// ==================== PROFILING ====================
+void writeProfileTraceAtExit() {
+    writeChromeTrace(profileTracePath);
+}
+
 // ==================== MAIN ====================
 int main(int argc, char** argv) {
     glutInit(&argc, argv);
@@ -1654,9 +723,49 @@ int main(int argc, char** argv) {
     glutInitWindowSize(1100, 700);
     glutCreateWindow("F1 Car Circuit (Constant Width)");
 
+    // --physics-hz N sets the fixed simulation rate (default 120)
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--physics-hz") == 0) {
+            float hz = (float)atof(argv[i + 1]);
+            if (hz > 0.0f) setFixedStepRate(sim.clock, hz);
+        }
+        // --audience N sets the number of trackside spectators
+        if (strcmp(argv[i], "--audience") == 0) {
+            int n = atoi(argv[i + 1]);
+            if (n >= 0) audienceSize = n;
+        }
+        // --seed N picks the generated world; the same seed gives the same world
+        if (strcmp(argv[i], "--seed") == 0) {
+            setWorldSeed((uint32_t)strtoul(argv[i + 1], nullptr, 10));
+        }
+        // --profile FILE records per-pass timings; P (and exit) writes a
+        // Chrome trace of the last PROFILE_RING_CAPACITY events to FILE
+        if (strcmp(argv[i], "--profile") == 0) {
+            profileTracePath = argv[i + 1];
+            profilerEnabled = true;
+        }
+        // --cars N puts N cars on the grid, the player's first and the rest
+        // driven by the AI
+        if (strcmp(argv[i], "--cars") == 0) {
+            int n = atoi(argv[i + 1]);
+            if (n >= 1) carCount = n;
+        }
+        // --world FILE loads the world for this seed from FILE, or generates
+        // it and writes FILE for the next launch
+        if (strcmp(argv[i], "--world") == 0) {
+            worldCachePath = argv[i + 1];
+        }
+    }
+    for (int i = 1; i < argc; i++) {
+        // --no-texture-cache always decodes the JPEGs and writes no .rtex files
+        if (strcmp(argv[i], "--no-texture-cache") == 0) textureCacheEnabled = false;
+    }
+    if (profileTracePath) atexit(writeProfileTraceAtExit);
+
     initGL();
-    resetCar();
-    lastTime = glutGet(GLUT_ELAPSED_TIME);
+    atexit(stopWorkersAtExit);
+    resetCars();
+    atexit(stopSimAtExit);
 
     glutDisplayFunc(display);
     glutReshapeFunc(reshape);